@@ -29,6 +29,7 @@ public class AIBuilder : ModuleRules
             "EditorStyle",
             "EditorWidgets",
             "GraphEditor",
+            "Json",
             "Kismet",
             "KismetWidgets",
             "SequenceRecorder"
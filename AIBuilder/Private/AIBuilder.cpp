@@ -3,10 +3,36 @@
 #include "Modules/ModuleManager.h"
 #include "Engine/Engine.h"
 #include "AICodeGenerator.h"
+#include "AICodeGenerationCache.h"
+#include "AIBuilderStats.h"
 
 DEFINE_LOG_CATEGORY(LogAIBuilder);
 DEFINE_LOG_CATEGORY(LogAICodeGen);
 
+DEFINE_STAT(STAT_AIBuilder_SensorScheduler);
+DEFINE_STAT(STAT_AIBuilder_SightCandidates);
+DEFINE_STAT(STAT_AIBuilder_SightCone);
+DEFINE_STAT(STAT_AIBuilder_SightTraces);
+DEFINE_STAT(STAT_AIBuilder_SightTraceResults);
+DEFINE_STAT(STAT_AIBuilder_Hearing);
+DEFINE_STAT(STAT_AIBuilder_Touch);
+DEFINE_STAT(STAT_AIBuilder_DetectionTable);
+DEFINE_STAT(STAT_AIBuilder_SpatialGridRebuild);
+DEFINE_STAT(STAT_AIBuilder_StateUpdate);
+DEFINE_STAT(STAT_AIBuilder_TickManager);
+DEFINE_STAT(STAT_AIBuilder_CodeGenParse);
+DEFINE_STAT(STAT_AIBuilder_CodeGenTemplates);
+DEFINE_STAT(STAT_AIBuilder_CodeGenValidate);
+DEFINE_STAT(STAT_AIBuilder_CodeGenSave);
+DEFINE_STAT(STAT_AIBuilder_CodeGenBatch);
+DEFINE_STAT(STAT_AIBuilder_ActiveDetections);
+DEFINE_STAT(STAT_AIBuilder_SightTracesIssued);
+DEFINE_STAT(STAT_AIBuilder_SensorsUpdated);
+DEFINE_STAT(STAT_AIBuilder_NoiseEvents);
+DEFINE_STAT(STAT_AIBuilder_StateTransitions);
+
+UE_TRACE_CHANNEL_DEFINE(AIBuilderChannel);
+
 UAICodeGenerator* FAIBuilderModule::CodeGenerator = nullptr;
 
 void FAIBuilderModule::StartupModule()
@@ -25,6 +51,8 @@ void FAIBuilderModule::ShutdownModule()
     {
         CodeGenerator = nullptr;
     }
+
+    FAICodeGenerationCache::Get().SaveIfDirty();
 }
 
 void FAIBuilderModule::RegisterComponents()
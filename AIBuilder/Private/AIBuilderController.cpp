@@ -5,6 +5,7 @@
 #include "Perception/AISenseConfig_Hearing.h"
 #include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BlackboardAsset.h"
+#include "Perception/AIPerceptionSystem.h"
 #include "AIBuilder.h"
 
 AAIBuilderController::AAIBuilderController()
@@ -37,6 +38,12 @@ void AAIBuilderController::OnPossess(APawn* InPawn)
     if (AAIBuilderCharacter* AICharacter = Cast<AAIBuilderCharacter>(InPawn))
     {
         LogAIStatus(FString::Printf(TEXT("Possessed %s"), *AICharacter->GetName()));
+
+        // Spawned at runtime our BeginPlay ran before possession and may have set up senses already
+        if (AICharacter->UsesUnifiedPerception())
+        {
+            DisablePerceptionSystem();
+        }
         
         // Use character's assets if available, otherwise use defaults
         if (AICharacter->BehaviorTree)
@@ -66,8 +73,38 @@ void AAIBuilderController::InitializeComponents()
     ConfigureBlackboard();
 }
 
+bool AAIBuilderController::UsesUnifiedPerception() const
+{
+    const AAIBuilderCharacter* AICharacter = Cast<AAIBuilderCharacter>(GetPawn());
+    return AICharacter && AICharacter->UsesUnifiedPerception();
+}
+
+void AAIBuilderController::DisablePerceptionSystem()
+{
+    if (!AIPerceptionComponent)
+    {
+        return;
+    }
+
+    AIPerceptionComponent->OnPerceptionUpdated.RemoveDynamic(this, &AAIBuilderController::OnPerceptionUpdated);
+
+    if (UAIPerceptionSystem* PerceptionSystem = UAIPerceptionSystem::GetCurrent(this))
+    {
+        PerceptionSystem->UnregisterListener(*AIPerceptionComponent);
+    }
+
+    AIPerceptionComponent->Deactivate();
+    UE_LOG(LogAIBuilder, Log, TEXT("Perception system disabled for %s, the pawn's sensor component is used instead"), *GetName());
+}
+
 void AAIBuilderController::SetupPerceptionSystem()
 {
+    if (UsesUnifiedPerception())
+    {
+        DisablePerceptionSystem();
+        return;
+    }
+
     if (AIPerceptionComponent)
     {
         // Configure sight sense
@@ -111,6 +148,7 @@ void AAIBuilderController::ConfigureBlackboard()
     if (DefaultBlackboard)
     {
         UseBlackboard(DefaultBlackboard);
+        BlackboardKeys.Resolve(BlackboardComponent);
         UE_LOG(LogAIBuilder, Log, TEXT("Blackboard configured for %s"), *GetName());
     }
 }
@@ -132,22 +170,16 @@ void AAIBuilderController::OnPerceptionUpdated(const TArray<AActor*>& UpdatedAct
                 if (Stimulus.WasSuccessfullySensed())
                 {
                     // Update blackboard with target information
-                    if (BlackboardComponent)
-                    {
-                        BlackboardComponent->SetValueAsObject(TEXT("TargetActor"), Actor);
-                        BlackboardComponent->SetValueAsVector(TEXT("TargetLocation"), Actor->GetActorLocation());
-                        BlackboardComponent->SetValueAsBool(TEXT("HasTarget"), true);
-                    }
+                    BlackboardKeys.SetTarget(BlackboardComponent, Actor);
                     
                     UE_LOG(LogAIBuilder, Log, TEXT("%s detected target: %s"), *GetName(), *Actor->GetName());
                 }
                 else
                 {
                     // Lost sight of target
-                    if (BlackboardComponent && BlackboardComponent->GetValueAsObject(TEXT("TargetActor")) == Actor)
+                    if (BlackboardKeys.GetTarget(BlackboardComponent) == Actor)
                     {
-                        BlackboardComponent->SetValueAsObject(TEXT("TargetActor"), nullptr);
-                        BlackboardComponent->SetValueAsBool(TEXT("HasTarget"), false);
+                        BlackboardKeys.SetTarget(BlackboardComponent, nullptr);
                         
                         UE_LOG(LogAIBuilder, Log, TEXT("%s lost target: %s"), *GetName(), *Actor->GetName());
                     }
@@ -0,0 +1,222 @@
+// AICodeGenerationCache.cpp - Generation cache implementation
+#include "AICodeGenerationCache.h"
+#include "Hash/xxhash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/ScopeRWLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "AIBuilder.h"
+
+namespace AICodeGenerationCache
+{
+    constexpr uint32 Magic = 0x43424941; // "AIBC"
+    constexpr uint32 Version = 1;
+
+    void SerializeCode(FArchive& Ar, FGeneratedCode& Code)
+    {
+        Ar << Code.HeaderCode << Code.SourceCode << Code.FileName << Code.bSuccess << Code.ErrorMessage;
+    }
+
+    // Length first, so ("ab", "c") and ("a", "bc") hash differently
+    void UpdateHash(FXxHash64Builder& Builder, FStringView Text)
+    {
+        const int32 Len = Text.Len();
+        Builder.Update(&Len, sizeof(Len));
+        Builder.Update(Text.GetData(), Len * sizeof(TCHAR));
+    }
+}
+
+FAICodeGenerationCache& FAICodeGenerationCache::Get()
+{
+    static FAICodeGenerationCache Cache;
+    return Cache;
+}
+
+FAICodeGenerationCache::FAICodeGenerationCache()
+{
+    bDirty = false;
+
+    TArray<uint8> Bytes;
+    if (FFileHelper::LoadFileToArray(Bytes, *GetCacheFilename(), FILEREAD_Silent))
+    {
+        FMemoryReader Reader(Bytes);
+        if (!Serialize(Reader))
+        {
+            // Written by an older version, or damaged. It is rebuilt as requests come in.
+            Entries.Reset();
+        }
+
+        UE_LOG(LogAICodeGen, Log, TEXT("Loaded %d cached code generation results"), Entries.Num());
+    }
+}
+
+FString FAICodeGenerationCache::NormalizeRequest(FStringView Request)
+{
+    TStringBuilder<256> Builder;
+    bool bPendingSpace = false;
+
+    for (TCHAR Char : Request)
+    {
+        if (FChar::IsWhitespace(Char))
+        {
+            bPendingSpace = Builder.Len() > 0;
+            continue;
+        }
+
+        if (bPendingSpace)
+        {
+            Builder.AppendChar(TEXT(' '));
+            bPendingSpace = false;
+        }
+        Builder.AppendChar(Char);
+    }
+
+    return FString(Builder.ToView());
+}
+
+uint64 FAICodeGenerationCache::MakeKey(uint64 TemplateVersion, FStringView Kind, FStringView Request, FStringView Extra)
+{
+    FXxHash64Builder Builder;
+    Builder.Update(&TemplateVersion, sizeof(TemplateVersion));
+    AICodeGenerationCache::UpdateHash(Builder, Kind);
+    AICodeGenerationCache::UpdateHash(Builder, Request);
+    AICodeGenerationCache::UpdateHash(Builder, Extra);
+    return Builder.Finalize().Hash;
+}
+
+bool FAICodeGenerationCache::Find(uint64 Key, FGeneratedCode& OutCode) const
+{
+    FReadScopeLock ReadLock(Lock);
+
+    if (const FGeneratedCode* Code = Entries.Find(Key))
+    {
+        OutCode = *Code;
+        return true;
+    }
+
+    return false;
+}
+
+void FAICodeGenerationCache::Add(uint64 Key, const FGeneratedCode& Code)
+{
+    FWriteScopeLock WriteLock(Lock);
+
+    if (Entries.Num() >= MaxEntries && !Entries.Contains(Key))
+    {
+        Entries.Reset();
+    }
+
+    Entries.Add(Key, Code);
+    bDirty = true;
+}
+
+int32 FAICodeGenerationCache::Num() const
+{
+    FReadScopeLock ReadLock(Lock);
+    return Entries.Num();
+}
+
+bool FAICodeGenerationCache::SaveIfDirty()
+{
+    // Keeps concurrent saves from writing an older snapshot over a newer one
+    FScopeLock SaveScopeLock(&SaveLock);
+
+    TArray<uint8> Bytes;
+    {
+        // Only the snapshot is taken under the lock, lookups don't wait on the disk
+        FWriteScopeLock WriteLock(Lock);
+
+        if (!bDirty)
+        {
+            return true;
+        }
+
+        FMemoryWriter Writer(Bytes);
+        if (!Serialize(Writer))
+        {
+            UE_LOG(LogAICodeGen, Error, TEXT("Failed to serialize the code generation cache"));
+            return false;
+        }
+
+        bDirty = false;
+    }
+
+    const FString Filename = GetCacheFilename();
+    if (!FFileHelper::SaveArrayToFile(Bytes, *Filename))
+    {
+        UE_LOG(LogAICodeGen, Error, TEXT("Failed to write code generation cache to %s"), *Filename);
+
+        FWriteScopeLock WriteLock(Lock);
+        bDirty = true;
+        return false;
+    }
+
+    return true;
+}
+
+bool FAICodeGenerationCache::Serialize(FArchive& Ar)
+{
+    uint32 Magic = AICodeGenerationCache::Magic;
+    uint32 Version = AICodeGenerationCache::Version;
+    Ar << Magic << Version;
+
+    if (Ar.IsLoading() && (Magic != AICodeGenerationCache::Magic || Version != AICodeGenerationCache::Version))
+    {
+        return false;
+    }
+
+    int32 NumEntries = Entries.Num();
+    Ar << NumEntries;
+
+    if (Ar.IsLoading())
+    {
+        if (NumEntries < 0 || NumEntries > MaxEntries)
+        {
+            return false;
+        }
+
+        Entries.Reset();
+        Entries.Reserve(NumEntries);
+
+        for (int32 i = 0; i < NumEntries && !Ar.IsError(); i++)
+        {
+            uint64 Key = 0;
+            FGeneratedCode Code;
+            Ar << Key;
+            AICodeGenerationCache::SerializeCode(Ar, Code);
+            Entries.Add(Key, MoveTemp(Code));
+        }
+    }
+    else
+    {
+        for (TPair<uint64, FGeneratedCode>& Entry : Entries)
+        {
+            Ar << Entry.Key;
+            AICodeGenerationCache::SerializeCode(Ar, Entry.Value);
+        }
+    }
+
+    return !Ar.IsError();
+}
+
+bool FAICodeGenerationCache::WriteFileIfChanged(const FString& Filename, const FString& Content, bool& bOutWritten)
+{
+    bOutWritten = false;
+
+    FString Existing;
+    if (FFileHelper::LoadFileToString(Existing, *Filename, FFileHelper::EHashOptions::None, FILEREAD_Silent)
+        && Existing.Equals(Content, ESearchCase::CaseSensitive))
+    {
+        return true;
+    }
+
+    bOutWritten = FFileHelper::SaveStringToFile(Content, *Filename);
+    return bOutWritten;
+}
+
+FString FAICodeGenerationCache::GetCacheFilename()
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AIBuilder"), TEXT("CodeGenCache.bin"));
+}
@@ -1,64 +1,26 @@
 // AICodeGenerator.cpp - AI Assistant Implementation
 #include "AICodeGenerator.h"
+#include "AICodeGenerationCache.h"
+#include "Algo/AnyOf.h"
+#include "Algo/Count.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Hash/xxhash.h"
 #include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "AIBuilder.h"
+#include "AIBuilderStats.h"
 
-UAICodeGenerator::UAICodeGenerator()
+namespace AICodeGeneratorTemplates
 {
-    Initialize();
-}
+    // Bump when parsing or rendering changes the output of unchanged templates, to invalidate cached results
+    constexpr uint32 GeneratorVersion = 3;
 
-void UAICodeGenerator::Initialize()
-{
-    InitializeTemplates();
-    InitializeAIKeywords();
-    InitializeCodeSnippets();
-    
-    UE_LOG(LogAICodeGen, Log, TEXT("AI Code Generator initialized with templates and keywords"));
-}
-
-FGeneratedCode UAICodeGenerator::GenerateCodeFromRequest(const FString& UserRequest)
-{
-    UE_LOG(LogAICodeGen, Log, TEXT("Processing user request: %s"), *UserRequest);
-    
-    FGeneratedCode Result;
-    
-    // Parse the user request
-    FCodeRequest ParsedRequest = ParseUserRequest(UserRequest);
-    
-    if (ParsedRequest.ClassName.IsEmpty())
-    {
-        Result.bSuccess = false;
-        Result.ErrorMessage = TEXT("Could not determine class name from request");
-        return Result;
-    }
-    
-    // Generate header and source code
-    Result.HeaderCode = GenerateHeaderTemplate(ParsedRequest);
-    Result.SourceCode = GenerateSourceTemplate(ParsedRequest);
-    Result.FileName = ParsedRequest.ClassName;
-    Result.bSuccess = ValidateGeneratedCode(Result.HeaderCode) && ValidateGeneratedCode(Result.SourceCode);
-    
-    if (!Result.bSuccess)
-    {
-        Result.ErrorMessage = TEXT("Generated code failed validation");
-    }
-    
-    UE_LOG(LogAICodeGen, Log, TEXT("Code generation %s for class %s"), 
-           Result.bSuccess ? TEXT("succeeded") : TEXT("failed"), 
-           *ParsedRequest.ClassName);
-    
-    return Result;
-}
-
-FGeneratedCode UAICodeGenerator::CreateAICharacter(const FString& CharacterName, const FString& BehaviorDescription)
-{
-    FGeneratedCode Result;
-    
-    FString HeaderCode = FString::Printf(TEXT(R"(
-// %s.h - AI Character generated by AI Code Generator
+    // Compiled into FAICodeTemplate at Initialize. {{ClassName}} is the name without its A/U prefix.
+    // {{Description}} is the raw request, use {{DescriptionLiteral}} inside string literals.
+    const TCHAR* const CharacterHeader = TEXT(R"(// {{ClassName}}.h - AI Character generated by AI Code Generator
 #pragma once
 
 #include "CoreMinimal.h"
@@ -67,15 +29,15 @@ FGeneratedCode UAICodeGenerator::CreateAICharacter(const FString& CharacterName,
 #include "BehaviorTree/BehaviorTreeComponent.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "Perception/AIPerceptionComponent.h"
-#include "%s.generated.h"
+#include "{{ClassName}}.generated.h"
 
 UCLASS(BlueprintType, Blueprintable)
-class AIBUILDER_API A%s : public ACharacter
+class AIBUILDER_API A{{ClassName}} : public ACharacter
 {
     GENERATED_BODY()
 
 public:
-    A%s();
+    A{{ClassName}}();
 
 protected:
     virtual void BeginPlay() override;
@@ -99,7 +61,7 @@ protected:
     class UBlackboardAsset* BlackboardAsset;
 
 public:
-    // Blueprint callable functions for %s
+    // Blueprint callable functions for {{Description}}
     UFUNCTION(BlueprintCallable, Category = "AI")
     void StartAI();
 
@@ -113,17 +75,16 @@ private:
     void InitializeAI();
     void SetupPerception();
 };
-)"), *CharacterName, *CharacterName, *CharacterName, *CharacterName, *BehaviorDescription);
+)");
 
-    FString SourceCode = FString::Printf(TEXT(R"(
-// %s.cpp - AI Character implementation
-#include "%s.h"
+    const TCHAR* const CharacterSource = TEXT(R"(// {{ClassName}}.cpp - AI Character implementation
+#include "{{ClassName}}.h"
 #include "AIController.h"
 #include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "Perception/AISenseConfig_Sight.h"
 
-A%s::A%s()
+A{{ClassName}}::A{{ClassName}}()
 {
     PrimaryActorTick.bCanEverTick = true;
 
@@ -133,19 +94,19 @@ A%s::A%s()
     BlackboardComponent = CreateDefaultSubobject<UBlackboardComponent>(TEXT("BlackboardComponent"));
 }
 
-void A%s::BeginPlay()
+void A{{ClassName}}::BeginPlay()
 {
     Super::BeginPlay();
     InitializeAI();
 }
 
-void A%s::Tick(float DeltaTime)
+void A{{ClassName}}::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
-    // Custom AI behavior for %s
+    // Custom AI behavior for {{Description}}
 }
 
-void A%s::InitializeAI()
+void A{{ClassName}}::InitializeAI()
 {
     if (AAIController* AIController = Cast<AAIController>(GetController()))
     {
@@ -159,7 +120,7 @@ void A%s::InitializeAI()
     }
 }
 
-void A%s::SetupPerception()
+void A{{ClassName}}::SetupPerception()
 {
     if (AIPerceptionComponent)
     {
@@ -173,7 +134,7 @@ void A%s::SetupPerception()
     }
 }
 
-void A%s::StartAI()
+void A{{ClassName}}::StartAI()
 {
     if (AAIController* AIController = Cast<AAIController>(GetController()))
     {
@@ -184,7 +145,7 @@ void A%s::StartAI()
     }
 }
 
-void A%s::StopAI()
+void A{{ClassName}}::StopAI()
 {
     if (AAIController* AIController = Cast<AAIController>(GetController()))
     {
@@ -192,48 +153,35 @@ void A%s::StopAI()
     }
 }
 
-void A%s::SetTarget(AActor* NewTarget)
+void A{{ClassName}}::SetTarget(AActor* NewTarget)
 {
     if (BlackboardComponent)
     {
         BlackboardComponent->SetValueAsObject(TEXT("TargetActor"), NewTarget);
     }
 }
-)"), *CharacterName, *CharacterName, *CharacterName, *CharacterName, *CharacterName, *CharacterName, *BehaviorDescription, *CharacterName, *CharacterName, *CharacterName, *CharacterName, *CharacterName);
-
-    Result.HeaderCode = HeaderCode;
-    Result.SourceCode = SourceCode;
-    Result.FileName = CharacterName;
-    Result.bSuccess = true;
-    
-    return Result;
-}
+)");
 
-FGeneratedCode UAICodeGenerator::CreateBehaviorTreeTask(const FString& TaskName, const FString& TaskDescription)
-{
-    FGeneratedCode Result;
-    
-    FString HeaderCode = FString::Printf(TEXT(R"(
-// %s.h - Behavior Tree Task generated by AI Code Generator
+    const TCHAR* const TaskHeader = TEXT(R"(// {{ClassName}}.h - Behavior Tree Task generated by AI Code Generator
 #pragma once
 
 #include "CoreMinimal.h"
 #include "BehaviorTree/BTTaskNode.h"
-#include "%s.generated.h"
+#include "{{ClassName}}.generated.h"
 
 UCLASS()
-class AIBUILDER_API U%s : public UBTTaskNode
+class AIBUILDER_API U{{ClassName}} : public UBTTaskNode
 {
     GENERATED_BODY()
 
 public:
-    U%s();
+    U{{ClassName}}();
 
     virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
     virtual FString GetStaticDescription() const override;
 
 protected:
-    // Task parameters for %s
+    // Task parameters for {{Description}}
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Task")
     float TaskDuration = 1.0f;
 
@@ -243,21 +191,20 @@ protected:
 private:
     bool ExecuteTaskLogic(UBehaviorTreeComponent& OwnerComp);
 };
-)"), *TaskName, *TaskName, *TaskName, *TaskName, *TaskDescription);
+)");
 
-    FString SourceCode = FString::Printf(TEXT(R"(
-// %s.cpp - Behavior Tree Task implementation
-#include "%s.h"
+    const TCHAR* const TaskSource = TEXT(R"(// {{ClassName}}.cpp - Behavior Tree Task implementation
+#include "{{ClassName}}.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "AIController.h"
 
-U%s::U%s()
+U{{ClassName}}::U{{ClassName}}()
 {
-    NodeName = TEXT("%s");
+    NodeName = TEXT("{{ClassName}}");
     bNotifyTick = true;
 }
 
-EBTNodeResult::Type U%s::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+EBTNodeResult::Type U{{ClassName}}::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
     if (ExecuteTaskLogic(OwnerComp))
     {
@@ -267,12 +214,12 @@ EBTNodeResult::Type U%s::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* N
     return EBTNodeResult::Failed;
 }
 
-FString U%s::GetStaticDescription() const
+FString U{{ClassName}}::GetStaticDescription() const
 {
-    return FString::Printf(TEXT("%s: %s"), *Super::GetStaticDescription(), TEXT("%s"));
+    return FString::Printf(TEXT("%s: %s"), *Super::GetStaticDescription(), TEXT("{{DescriptionLiteral}}"));
 }
 
-bool U%s::ExecuteTaskLogic(UBehaviorTreeComponent& OwnerComp)
+bool U{{ClassName}}::ExecuteTaskLogic(UBehaviorTreeComponent& OwnerComp)
 {
     AAIController* AIController = OwnerComp.GetAIOwner();
     if (!AIController)
@@ -286,48 +233,280 @@ bool U%s::ExecuteTaskLogic(UBehaviorTreeComponent& OwnerComp)
         return false;
     }
 
-    // Custom task logic for %s
+    // Custom task logic for {{Description}}
     // TODO: Implement specific behavior based on task description
     
     return true;
 }
-)"), *TaskName, *TaskName, *TaskName, *TaskName, *TaskName, *TaskName, *TaskName, *TaskDescription, *TaskName, *TaskDescription);
+)");
+}
 
-    Result.HeaderCode = HeaderCode;
-    Result.SourceCode = SourceCode;
-    Result.FileName = TaskName;
-    Result.bSuccess = true;
+namespace AICodeGeneratorNames
+{
+    // Last word before End that names the class, e.g. "Sentry" in "a Sentry behavior tree task".
+    // Qualifiers of the class type are skipped, articles mean the request gave no name.
+    FString FindNameBefore(const FString& Request, int32 End)
+    {
+        static const TCHAR* const Qualifiers[] = { TEXT("behavior"), TEXT("behaviour"), TEXT("tree"), TEXT("bt") };
+        static const TCHAR* const Articles[] = { TEXT("a"), TEXT("an"), TEXT("the"), TEXT("new"), TEXT("create") };
+
+        TArray<FString> Words;
+        Request.Left(End).ParseIntoArray(Words, TEXT(" "));
+
+        for (int32 i = Words.Num() - 1; i >= 0; i--)
+        {
+            auto Matches = [&Word = Words[i]](const TCHAR* Candidate) { return Word.Equals(Candidate, ESearchCase::IgnoreCase); };
+            if (Algo::AnyOf(Qualifiers, Matches))
+            {
+                continue;
+            }
+
+            return Algo::AnyOf(Articles, Matches) ? FString() : Words[i];
+        }
+
+        return FString();
+    }
+}
+
+UAICodeGenerator::UAICodeGenerator()
+{
+    Initialize();
+}
+
+void UAICodeGenerator::BeginDestroy()
+{
+    // Queued writes don't reference the generator, but they should land before shutdown
+    FlushPendingSaves();
+
+    Super::BeginDestroy();
+}
+
+void UAICodeGenerator::Initialize()
+{
+    InitializeTemplates();
+    InitializeAIKeywords();
+    InitializeCodeSnippets();
+    BuildKeywordMatcher();
+    
+    UE_LOG(LogAICodeGen, Log, TEXT("AI Code Generator initialized with templates and keywords"));
+}
+
+FGeneratedCode UAICodeGenerator::GenerateCodeFromRequest(const FString& UserRequest)
+{
+    // Requests that only differ in whitespace generate the same code
+    const FString Request = FAICodeGenerationCache::NormalizeRequest(UserRequest);
+    if (!bUseGenerationCache)
+    {
+        return RenderRequest(Request);
+    }
+
+    const uint64 CacheKey = FAICodeGenerationCache::MakeKey(TemplateVersion, TEXT("Request"), Request);
+
+    FGeneratedCode Result;
+    if (FAICodeGenerationCache::Get().Find(CacheKey, Result))
+    {
+        UE_LOG(LogAICodeGen, Verbose, TEXT("Cached result for request: %s"), *Request);
+        return Result;
+    }
+
+    // Failures are not cached, they are cheap to reproduce and a fix to the generator should see them again
+    Result = RenderRequest(Request);
+    if (Result.bSuccess)
+    {
+        FAICodeGenerationCache::Get().Add(CacheKey, Result);
+    }
+    return Result;
+}
+
+FGeneratedCode UAICodeGenerator::RenderRequest(const FString& UserRequest)
+{
+    UE_LOG(LogAICodeGen, Verbose, TEXT("Processing user request: %s"), *UserRequest);
+    
+    FGeneratedCode Result;
+    
+    // Parse the user request
+    FCodeRequest ParsedRequest;
+    {
+        AIBUILDER_SCOPE_CYCLE_COUNTER(STAT_AIBuilder_CodeGenParse);
+        ParsedRequest = ParseUserRequest(UserRequest);
+    }
+    
+    if (ParsedRequest.ClassName.IsEmpty())
+    {
+        Result.bSuccess = false;
+        Result.ErrorMessage = TEXT("Could not determine class name from request");
+        return Result;
+    }
+    
+    // Generate header and source code
+    {
+        AIBUILDER_SCOPE_CYCLE_COUNTER(STAT_AIBuilder_CodeGenTemplates);
+        Result.HeaderCode = GenerateHeaderTemplate(ParsedRequest);
+        Result.SourceCode = GenerateSourceTemplate(ParsedRequest);
+        Result.FileName = ParsedRequest.ClassName;
+    }
+
+    {
+        AIBUILDER_SCOPE_CYCLE_COUNTER(STAT_AIBuilder_CodeGenValidate);
+        // The class declaration and GENERATED_BODY live in the header, the source only defines members
+        Result.bSuccess = ValidateGeneratedCode(Result.HeaderCode) && !Result.SourceCode.IsEmpty();
+    }
+    
+    if (!Result.bSuccess)
+    {
+        Result.ErrorMessage = TEXT("Generated code failed validation");
+    }
+    
+    UE_LOG(LogAICodeGen, Verbose, TEXT("Code generation %s for class %s"), 
+           Result.bSuccess ? TEXT("succeeded") : TEXT("failed"), 
+           *ParsedRequest.ClassName);
     
     return Result;
 }
 
+TArray<FGeneratedCode> UAICodeGenerator::GenerateBatch(const TArray<FString>& UserRequests, bool bParallel)
+{
+    AIBUILDER_SCOPE_CYCLE_COUNTER(STAT_AIBuilder_CodeGenBatch);
+
+    TArray<FGeneratedCode> Results;
+    Results.SetNum(UserRequests.Num());
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    // Every request writes only its own slot, so results come back in request order
+    ParallelFor(UserRequests.Num(), [this, &UserRequests, &Results](int32 Index)
+    {
+        Results[Index] = GenerateCodeFromRequest(UserRequests[Index]);
+    }, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+    const int32 NumSucceeded = Algo::CountIf(Results, [](const FGeneratedCode& Code) { return Code.bSuccess; });
+    UE_LOG(LogAICodeGen, Log, TEXT("Batch of %d requests (%d succeeded) generated %s in %.2f ms"),
+           UserRequests.Num(), NumSucceeded, bParallel ? TEXT("in parallel") : TEXT("serially"),
+           (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+    // Saving these would overwrite one file with another
+    TMap<FString, int32> FileNameCounts;
+    for (const FGeneratedCode& Code : Results)
+    {
+        if (Code.bSuccess)
+        {
+            FileNameCounts.FindOrAdd(Code.FileName)++;
+        }
+    }
+
+    for (const TPair<FString, int32>& FileNameCount : FileNameCounts)
+    {
+        if (FileNameCount.Value > 1)
+        {
+            UE_LOG(LogAICodeGen, Warning, TEXT("%d requests in the batch generate %s, saving them writes the same files"),
+                   FileNameCount.Value, *FileNameCount.Key);
+        }
+    }
+
+    FAICodeGenerationCache::Get().SaveIfDirty();
+
+    return Results;
+}
+
+FGeneratedCode UAICodeGenerator::CreateAICharacter(const FString& CharacterName, const FString& BehaviorDescription)
+{
+    AIBUILDER_SCOPE_CYCLE_COUNTER(STAT_AIBuilder_CodeGenTemplates);
+
+    const FString Description = FAICodeGenerationCache::NormalizeRequest(BehaviorDescription);
+    const uint64 CacheKey = FAICodeGenerationCache::MakeKey(TemplateVersion, TEXT("Character"), Description, CharacterName);
+
+    FGeneratedCode Result;
+    if (bUseGenerationCache && FAICodeGenerationCache::Get().Find(CacheKey, Result))
+    {
+        return Result;
+    }
+
+    const FString DescriptionLiteral = Description.ReplaceCharWithEscapedChar();
+
+    FAICodeTemplateArgs Args;
+    Args.Add(TEXT("ClassName"), CharacterName).Add(TEXT("Description"), Description).Add(TEXT("DescriptionLiteral"), DescriptionLiteral);
+
+    Result = RenderTemplates(TEXT("Character"), Args, CharacterName);
+    if (bUseGenerationCache && Result.bSuccess)
+    {
+        FAICodeGenerationCache::Get().Add(CacheKey, Result);
+    }
+    return Result;
+}
+
+FGeneratedCode UAICodeGenerator::CreateBehaviorTreeTask(const FString& TaskName, const FString& TaskDescription)
+{
+    AIBUILDER_SCOPE_CYCLE_COUNTER(STAT_AIBuilder_CodeGenTemplates);
+
+    const FString Description = FAICodeGenerationCache::NormalizeRequest(TaskDescription);
+    const uint64 CacheKey = FAICodeGenerationCache::MakeKey(TemplateVersion, TEXT("Task"), Description, TaskName);
+
+    FGeneratedCode Result;
+    if (bUseGenerationCache && FAICodeGenerationCache::Get().Find(CacheKey, Result))
+    {
+        return Result;
+    }
+
+    const FString DescriptionLiteral = Description.ReplaceCharWithEscapedChar();
+
+    FAICodeTemplateArgs Args;
+    Args.Add(TEXT("ClassName"), TaskName).Add(TEXT("Description"), Description).Add(TEXT("DescriptionLiteral"), DescriptionLiteral);
+
+    Result = RenderTemplates(TEXT("Task"), Args, TaskName);
+    if (bUseGenerationCache && Result.bSuccess)
+    {
+        FAICodeGenerationCache::Get().Add(CacheKey, Result);
+    }
+    return Result;
+}
+
+FGeneratedCode UAICodeGenerator::RenderTemplates(const FString& TemplateKey, const FAICodeTemplateArgs& Args, const FString& FileName) const
+{
+    FGeneratedCode Result;
+
+    const FAICodeTemplate* HeaderTemplate = CompiledHeaderTemplates.Find(TemplateKey);
+    const FAICodeTemplate* SourceTemplate = CompiledSourceTemplates.Find(TemplateKey);
+    if (!HeaderTemplate || !SourceTemplate)
+    {
+        Result.ErrorMessage = FString::Printf(TEXT("No compiled template for %s"), *TemplateKey);
+        return Result;
+    }
+
+    Result.HeaderCode = HeaderTemplate->Render(Args);
+    Result.SourceCode = SourceTemplate->Render(Args);
+    Result.FileName = FileName;
+    Result.bSuccess = true;
+
+    return Result;
+}
+
 FCodeRequest UAICodeGenerator::ParseUserRequest(const FString& UserRequest)
 {
     FCodeRequest Request;
     Request.UserRequest = UserRequest;
     
+    // One pass over the request finds every keyword the steps below need
+    const FCodeRequestScan Scan = ScanRequest(UserRequest);
+    
     // Extract class name
-    Request.ClassName = ExtractClassName(UserRequest);
+    Request.ClassName = ExtractClassName(UserRequest, Scan);
     
     // Determine base class
-    Request.BaseClass = DetermineBaseClass(UserRequest);
+    Request.BaseClass = DetermineBaseClass(Scan);
     
     // Extract features
-    TArray<FString> Features = ExtractRequiredFeatures(UserRequest);
+    TArray<FString> Features = ExtractRequiredFeatures(Scan);
     Request.Functions = Features;
     
     return Request;
 }
 
-FString UAICodeGenerator::ExtractClassName(const FString& Request)
+FString UAICodeGenerator::ExtractClassName(const FString& Request, const FCodeRequestScan& Scan)
 {
-    // Simple pattern matching for class names
-    FString LowerRequest = Request.ToLower();
-    
-    if (LowerRequest.Contains(TEXT("character")) || LowerRequest.Contains(TEXT("ai character")))
+    if (Scan.ClassType == TEXT("character"))
     {
         // Extract name before "character"
-        int32 CharacterIndex = LowerRequest.Find(TEXT("character"));
+        int32 CharacterIndex = Scan.ClassTypeIndex;
         if (CharacterIndex > 0)
         {
             FString NamePart = Request.Left(CharacterIndex).TrimEnd();
@@ -341,45 +520,141 @@ FString UAICodeGenerator::ExtractClassName(const FString& Request)
         return TEXT("AICharacter");
     }
     
-    if (LowerRequest.Contains(TEXT("controller")))
+    if (Scan.ClassType == TEXT("controller"))
     {
         return TEXT("AIController");
     }
     
-    if (LowerRequest.Contains(TEXT("task")))
+    if (Scan.ClassType == TEXT("task"))
     {
-        return TEXT("BTTask");
+        // Named like the engine's tasks, so a batch of task requests doesn't write one file over and over
+        const FString Name = AICodeGeneratorNames::FindNameBefore(Request, Scan.ClassTypeIndex);
+        return Name.IsEmpty() ? FString(TEXT("BTTask")) : TEXT("BTTask_") + CapitalizeFirstLetter(Name);
     }
     
     return TEXT("GeneratedClass");
 }
 
-FString UAICodeGenerator::DetermineBaseClass(const FString& Request)
+FString UAICodeGenerator::DetermineBaseClass(const FCodeRequestScan& Scan)
 {
-    FString LowerRequest = Request.ToLower();
-    
-    if (LowerRequest.Contains(TEXT("character")))
-        return TEXT("ACharacter");
-    if (LowerRequest.Contains(TEXT("controller")))
-        return TEXT("AAIController");
-    if (LowerRequest.Contains(TEXT("task")))
-        return TEXT("UBTTaskNode");
-    if (LowerRequest.Contains(TEXT("component")))
-        return TEXT("UActorComponent");
-    
-    return TEXT("UObject");
+    return Scan.BaseClass;
+}
+
+TArray<FString> UAICodeGenerator::ExtractRequiredFeatures(const FCodeRequestScan& Scan)
+{
+    return Scan.Features;
+}
+
+FCodeRequestScan UAICodeGenerator::ScanRequest(const FString& Request) const
+{
+    FCodeRequestScan Scan;
+
+    TArray<FAIKeywordMatch> Matches;
+    KeywordMatcher.Scan(Request, Matches);
+
+    int32 BestPriority = INDEX_NONE;
+    for (const FAIKeywordMatch& Match : Matches)
+    {
+        const FKeywordInfo& Info = KeywordInfos[Match.PatternIndex];
+        Scan.Keywords.AddUnique(Info.Keyword);
+
+        if (!Info.Feature.IsEmpty())
+        {
+            Scan.Features.AddUnique(Info.Feature);
+        }
+
+        // Matches come in text order, so the first one of the winning type is its first occurrence
+        if (Info.ClassTypePriority != INDEX_NONE && (BestPriority == INDEX_NONE || Info.ClassTypePriority < BestPriority))
+        {
+            BestPriority = Info.ClassTypePriority;
+            Scan.ClassType = Info.Keyword;
+            Scan.ClassTypeIndex = Match.Start;
+            Scan.BaseClass = Info.BaseClass;
+        }
+    }
+
+    return Scan;
+}
+
+void UAICodeGenerator::BuildKeywordMatcher()
+{
+    KeywordMatcher.Reset();
+    KeywordInfos.Reset();
+
+    // Null for an empty keyword, which the matcher doesn't take
+    auto AddKeyword = [this](const FString& Keyword) -> FKeywordInfo*
+    {
+        const int32 PatternIndex = KeywordMatcher.AddPattern(Keyword);
+        if (PatternIndex == INDEX_NONE)
+        {
+            return nullptr;
+        }
+
+        if (PatternIndex == KeywordInfos.Num())
+        {
+            KeywordInfos.AddDefaulted_GetRef().Keyword = Keyword.ToLower();
+        }
+        return &KeywordInfos[PatternIndex];
+    };
+
+    for (int32 Priority = 0; Priority < ClassTypePatterns.Num(); Priority++)
+    {
+        FKeywordInfo* Info = AddKeyword(ClassTypePatterns[Priority].Key);
+        if (Info && Info->ClassTypePriority == INDEX_NONE)
+        {
+            Info->BaseClass = ClassTypePatterns[Priority].Value;
+            Info->ClassTypePriority = Priority;
+        }
+    }
+
+    for (const TPair<FString, FString>& Keyword : AIKeywords)
+    {
+        if (FKeywordInfo* Info = AddKeyword(Keyword.Key))
+        {
+            Info->Feature = Keyword.Value;
+        }
+    }
+
+    KeywordMatcher.Build();
 }
 
 void UAICodeGenerator::InitializeTemplates()
 {
     // Initialize code templates
-    HeaderTemplates.Add(TEXT("Character"), TEXT("ACharacter header template"));
-    HeaderTemplates.Add(TEXT("Controller"), TEXT("AAIController header template"));
-    HeaderTemplates.Add(TEXT("Task"), TEXT("UBTTaskNode header template"));
+    HeaderTemplates.Add(TEXT("Character"), AICodeGeneratorTemplates::CharacterHeader);
+    HeaderTemplates.Add(TEXT("Task"), AICodeGeneratorTemplates::TaskHeader);
     
-    SourceTemplates.Add(TEXT("Character"), TEXT("ACharacter source template"));
-    SourceTemplates.Add(TEXT("Controller"), TEXT("AAIController source template"));
-    SourceTemplates.Add(TEXT("Task"), TEXT("UBTTaskNode source template"));
+    SourceTemplates.Add(TEXT("Character"), AICodeGeneratorTemplates::CharacterSource);
+    SourceTemplates.Add(TEXT("Task"), AICodeGeneratorTemplates::TaskSource);
+
+    // Parse every template once, rendering only walks the compiled segments
+    CompiledHeaderTemplates.Reset();
+    CompiledSourceTemplates.Reset();
+
+    for (const TPair<FString, FString>& Template : HeaderTemplates)
+    {
+        CompiledHeaderTemplates.Add(Template.Key, FAICodeTemplate(Template.Value));
+    }
+
+    for (const TPair<FString, FString>& Template : SourceTemplates)
+    {
+        CompiledSourceTemplates.Add(Template.Key, FAICodeTemplate(Template.Value));
+    }
+
+    // Editing any template invalidates the cached results without a manual version bump
+    FXxHash64Builder VersionHash;
+    VersionHash.Update(&AICodeGeneratorTemplates::GeneratorVersion, sizeof(AICodeGeneratorTemplates::GeneratorVersion));
+
+    for (const TMap<FString, FString>* Templates : { &HeaderTemplates, &SourceTemplates })
+    {
+        for (const TPair<FString, FString>& Template : *Templates)
+        {
+            VersionHash.Update(*Template.Key, (Template.Key.Len() + 1) * sizeof(TCHAR));
+            VersionHash.Update(*Template.Value, (Template.Value.Len() + 1) * sizeof(TCHAR));
+        }
+    }
+
+    TemplateVersion = VersionHash.Finalize().Hash;
 }
 
 void UAICodeGenerator::InitializeAIKeywords()
@@ -389,20 +664,70 @@ void UAICodeGenerator::InitializeAIKeywords()
     AIKeywords.Add(TEXT("attack"), TEXT("AttackBehavior"));
     AIKeywords.Add(TEXT("guard"), TEXT("GuardBehavior"));
     AIKeywords.Add(TEXT("follow"), TEXT("FollowBehavior"));
+
+    // Class types in priority order, when a request names several the earlier entry picks the base class
+    ClassTypePatterns.Reset();
+    ClassTypePatterns.Emplace(TEXT("character"), TEXT("ACharacter"));
+    ClassTypePatterns.Emplace(TEXT("controller"), TEXT("AAIController"));
+    ClassTypePatterns.Emplace(TEXT("task"), TEXT("UBTTaskNode"));
+    ClassTypePatterns.Emplace(TEXT("component"), TEXT("UActorComponent"));
 }
 
 FString UAICodeGenerator::GenerateHeaderTemplate(const FCodeRequest& Request)
 {
+    const TCHAR* TemplateKey = FindTemplateKey(Request.BaseClass);
+    if (const FAICodeTemplate* Template = TemplateKey ? CompiledHeaderTemplates.Find(TemplateKey) : nullptr)
+    {
+        FString DescriptionLiteral;
+        return Template->Render(MakeTemplateArgs(Request, DescriptionLiteral));
+    }
+
     // Generate basic header template
     return FString::Printf(TEXT("// Generated header for %s"), *Request.ClassName);
 }
 
 FString UAICodeGenerator::GenerateSourceTemplate(const FCodeRequest& Request)
 {
+    const TCHAR* TemplateKey = FindTemplateKey(Request.BaseClass);
+    if (const FAICodeTemplate* Template = TemplateKey ? CompiledSourceTemplates.Find(TemplateKey) : nullptr)
+    {
+        FString DescriptionLiteral;
+        return Template->Render(MakeTemplateArgs(Request, DescriptionLiteral));
+    }
+
     // Generate basic source template
     return FString::Printf(TEXT("// Generated source for %s"), *Request.ClassName);
 }
 
+const TCHAR* UAICodeGenerator::FindTemplateKey(const FString& BaseClass) const
+{
+    if (BaseClass == TEXT("ACharacter"))
+        return TEXT("Character");
+    if (BaseClass == TEXT("UBTTaskNode"))
+        return TEXT("Task");
+
+    return nullptr;
+}
+
+FAICodeTemplateArgs UAICodeGenerator::MakeTemplateArgs(const FCodeRequest& Request, FString& OutDescriptionLiteral) const
+{
+    OutDescriptionLiteral = Request.UserRequest.ReplaceCharWithEscapedChar();
+
+    FAICodeTemplateArgs Args;
+    Args.Add(TEXT("ClassName"), Request.ClassName)
+        .Add(TEXT("BaseClass"), Request.BaseClass)
+        .Add(TEXT("Description"), Request.UserRequest)
+        .Add(TEXT("DescriptionLiteral"), OutDescriptionLiteral);
+
+    return Args;
+}
+
+FString UAICodeGenerator::ReplaceTemplateVariables(const FString& Template, const FCodeRequest& Request)
+{
+    FString DescriptionLiteral;
+    return FAICodeTemplate(Template).Render(MakeTemplateArgs(Request, DescriptionLiteral));
+}
+
 bool UAICodeGenerator::ValidateGeneratedCode(const FString& Code)
 {
     // Basic validation - check for required elements
@@ -418,20 +743,66 @@ FString UAICodeGenerator::CapitalizeFirstLetter(const FString& Input)
 }
 
 void UAICodeGenerator::SaveGeneratedCode(const FGeneratedCode& Code, const FString& OutputPath)
+{
+    SaveGeneratedCode(Code, OutputPath, nullptr);
+}
+
+void UAICodeGenerator::SaveGeneratedCode(const FGeneratedCode& Code, const FString& OutputPath, TFunction<void(bool bSaved)> OnSaved)
 {
     if (!Code.bSuccess)
     {
         UE_LOG(LogAICodeGen, Error, TEXT("Cannot save failed code generation"));
+        if (OnSaved)
+        {
+            OnSaved(false);
+        }
         return;
     }
-    
-    FString HeaderPath = FPaths::Combine(OutputPath, Code.FileName + TEXT(".h"));
-    FString SourcePath = FPaths::Combine(OutputPath, Code.FileName + TEXT(".cpp"));
-    
-    FFileHelper::SaveStringToFile(Code.HeaderCode, *HeaderPath);
-    FFileHelper::SaveStringToFile(Code.SourceCode, *SourcePath);
-    
-    UE_LOG(LogAICodeGen, Log, TEXT("Saved generated code to %s"), *OutputPath);
+
+    // Generation carries on while the pipe writes the previous results one after another
+    SavePipe.Launch(TEXT("AICodeGeneratorSave"), [Code, OutputPath, OnSaved = MoveTemp(OnSaved)]()
+    {
+        AIBUILDER_SCOPE_CYCLE_COUNTER(STAT_AIBuilder_CodeGenSave);
+
+        FString HeaderPath = FPaths::Combine(OutputPath, Code.FileName + TEXT(".h"));
+        FString SourcePath = FPaths::Combine(OutputPath, Code.FileName + TEXT(".cpp"));
+
+        // Unchanged files keep their timestamps, so UBT doesn't recompile them
+        bool bHeaderWritten = false;
+        bool bSourceWritten = false;
+        const bool bSaved = FAICodeGenerationCache::WriteFileIfChanged(HeaderPath, Code.HeaderCode, bHeaderWritten)
+            && FAICodeGenerationCache::WriteFileIfChanged(SourcePath, Code.SourceCode, bSourceWritten);
+
+        if (bSaved)
+        {
+            if (bHeaderWritten || bSourceWritten)
+            {
+                UE_LOG(LogAICodeGen, Log, TEXT("Saved generated code to %s"), *OutputPath);
+            }
+            else
+            {
+                UE_LOG(LogAICodeGen, Verbose, TEXT("%s in %s is up to date"), *Code.FileName, *OutputPath);
+            }
+        }
+        else
+        {
+            UE_LOG(LogAICodeGen, Error, TEXT("Failed to save %s to %s"), *Code.FileName, *OutputPath);
+        }
+
+        if (OnSaved)
+        {
+            AsyncTask(ENamedThreads::GameThread, [OnSaved, bSaved]()
+            {
+                OnSaved(bSaved);
+            });
+        }
+    });
+}
+
+void UAICodeGenerator::FlushPendingSaves()
+{
+    SavePipe.WaitUntilEmpty();
+    FAICodeGenerationCache::Get().SaveIfDirty();
 }
 
 TArray<FString> UAICodeGenerator::GetAvailableTemplates() const
@@ -442,7 +813,6 @@ TArray<FString> UAICodeGenerator::GetAvailableTemplates() const
 }
 
 // Placeholder implementations for remaining functions
-TArray<FString> UAICodeGenerator::ExtractRequiredFeatures(const FString& Request) { return TArray<FString>(); }
 void UAICodeGenerator::InitializeCodeSnippets() {}
 FGeneratedCode UAICodeGenerator::CreateAIController(const FString& ControllerName, const FString& ControllerType) { return FGeneratedCode(); }
 FGeneratedCode UAICodeGenerator::CreateAIComponent(const FString& ComponentName, const FString& ComponentPurpose) { return FGeneratedCode(); }
@@ -457,6 +827,5 @@ FString UAICodeGenerator::GenerateAIComponentCode(const FString& ComponentName,
 FString UAICodeGenerator::FormatCode(const FString& Code) { return Code; }
 FString UAICodeGenerator::AddIncludes(const TArray<FString>& Includes) { return TEXT(""); }
 FString UAICodeGenerator::AddNamespaces() { return TEXT(""); }
-FString UAICodeGenerator::ReplaceTemplateVariables(const FString& Template, const FCodeRequest& Request) { return Template; }
 bool UAICodeGenerator::ContainsKeyword(const FString& Text, const FString& Keyword) { return Text.Contains(Keyword); }
 FString UAICodeGenerator::GenerateUniqueClassName(const FString& BaseName) { return BaseName; }
\ No newline at end of file
@@ -0,0 +1,392 @@
+// AICodeGeneratorWidget.cpp - Blueprint Widget Implementation
+#include "AICodeGeneratorWidget.h"
+#include "Components/EditableTextBox.h"
+#include "Components/Button.h"
+#include "Components/TextBlock.h"
+#include "Components/MultiLineEditableTextBox.h"
+#include "Components/ProgressBar.h"
+#include "AIBuilder.h"
+#include "Async/Async.h"
+#include "Misc/Paths.h"
+#include <atomic>
+
+struct FAICodeGenerationJob
+{
+    std::atomic<bool> bCancelled{ false };
+
+    // 0 to 1, written by the task and read by the widget tick
+    std::atomic<float> Progress{ 0.0f };
+};
+
+UAICodeGeneratorWidget::UAICodeGeneratorWidget(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+    CodeGenerator = nullptr;
+    DisplayedProgress = -1.0f;
+}
+
+void UAICodeGeneratorWidget::NativeConstruct()
+{
+    Super::NativeConstruct();
+    
+    InitializeCodeGenerator();
+    
+    // Bind button events
+    if (GenerateButton)
+    {
+        GenerateButton->OnClicked.AddDynamic(this, &UAICodeGeneratorWidget::OnGenerateButtonClicked);
+    }
+    
+    if (SaveButton)
+    {
+        SaveButton->OnClicked.AddDynamic(this, &UAICodeGeneratorWidget::OnSaveButtonClicked);
+    }
+
+    if (CancelButton)
+    {
+        CancelButton->OnClicked.AddDynamic(this, &UAICodeGeneratorWidget::OnCancelButtonClicked);
+    }
+
+    if (HeaderCodeBox)
+    {
+        HeaderCodeBox->OnTextChanged.AddDynamic(this, &UAICodeGeneratorWidget::OnHeaderCodeChanged);
+    }
+
+    if (SourceCodeBox)
+    {
+        SourceCodeBox->OnTextChanged.AddDynamic(this, &UAICodeGeneratorWidget::OnSourceCodeChanged);
+    }
+    
+    // Set initial UI state
+    SetProgressVisible(false);
+    UpdateUI();
+    ShowStatus(TEXT("AI Code Generator ready. Enter your request and click Generate!"));
+}
+
+void UAICodeGeneratorWidget::NativeDestruct()
+{
+    CancelGeneration();
+
+    Super::NativeDestruct();
+}
+
+void UAICodeGeneratorWidget::BeginDestroy()
+{
+    // The task uses CodeGenerator, which may be collected together with us
+    if (ActiveJob)
+    {
+        ActiveJob->bCancelled = true;
+    }
+    GenerationTask.Wait();
+
+    Super::BeginDestroy();
+}
+
+void UAICodeGeneratorWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+    Super::NativeTick(MyGeometry, InDeltaTime);
+
+    if (ActiveJob && GenerationProgressBar)
+    {
+        const float Progress = ActiveJob->Progress.load(std::memory_order_relaxed);
+        if (Progress != DisplayedProgress)
+        {
+            DisplayedProgress = Progress;
+            GenerationProgressBar->SetPercent(Progress);
+        }
+    }
+}
+
+void UAICodeGeneratorWidget::InitializeCodeGenerator()
+{
+    if (!CodeGenerator)
+    {
+        CodeGenerator = NewObject<UAICodeGenerator>(this);
+        if (CodeGenerator)
+        {
+            CodeGenerator->Initialize();
+            UE_LOG(LogAICodeGen, Log, TEXT("Code Generator initialized in widget"));
+        }
+    }
+}
+
+void UAICodeGeneratorWidget::OnGenerateButtonClicked()
+{
+    GenerateCodeFromInput();
+}
+
+void UAICodeGeneratorWidget::OnSaveButtonClicked()
+{
+    SaveGeneratedCode();
+}
+
+void UAICodeGeneratorWidget::OnCancelButtonClicked()
+{
+    CancelGeneration();
+}
+
+void UAICodeGeneratorWidget::OnHeaderCodeChanged(const FText& Text)
+{
+    // The box no longer shows what we set, so the next result must be written even if it is the same
+    DisplayedHeaderCode.Reset();
+}
+
+void UAICodeGeneratorWidget::OnSourceCodeChanged(const FText& Text)
+{
+    DisplayedSourceCode.Reset();
+}
+
+void UAICodeGeneratorWidget::GenerateCodeFromInput()
+{
+    if (!CodeGenerator || !RequestTextBox)
+    {
+        ShowStatus(TEXT("Error: Code generator not initialized"), true);
+        return;
+    }
+    
+    FString UserRequest = RequestTextBox->GetText().ToString();
+    if (UserRequest.IsEmpty())
+    {
+        ShowStatus(TEXT("Please enter a request"), true);
+        return;
+    }
+    
+    // A newer request replaces the one still running
+    if (ActiveJob)
+    {
+        ActiveJob->bCancelled = true;
+    }
+
+    TSharedPtr<FAICodeGenerationJob> Job = MakeShared<FAICodeGenerationJob>();
+    ActiveJob = Job;
+
+    ShowStatus(TEXT("Generating code..."));
+    SetProgressVisible(true);
+
+    // The generator only reads state built at Initialize, so it can run off the game thread.
+    // The UPROPERTY reference keeps it alive, and BeginDestroy waits for the task.
+    UAICodeGenerator* Generator = CodeGenerator;
+    TWeakObjectPtr<UAICodeGeneratorWidget> WeakThis(this);
+
+    auto Generate = [Job, Generator, UserRequest, WeakThis]()
+    {
+        if (Job->bCancelled)
+        {
+            return;
+        }
+
+        // Generate code based on request type
+        const FCodeRequestScan Scan = Generator->ScanRequest(UserRequest);
+        Job->Progress = 0.25f;
+
+        FGeneratedCode Code;
+        if (Scan.ClassType == TEXT("character"))
+        {
+            FString CharacterName = TEXT("MyAICharacter");
+            Code = Generator->CreateAICharacter(CharacterName, UserRequest);
+        }
+        else if (Scan.Keywords.Contains(TEXT("task")))
+        {
+            FString TaskName = TEXT("MyBehaviorTask");
+            Code = Generator->CreateBehaviorTreeTask(TaskName, UserRequest);
+        }
+        else
+        {
+            Code = Generator->GenerateCodeFromRequest(UserRequest);
+        }
+        Job->Progress = 0.9f;
+
+        if (Job->bCancelled)
+        {
+            return;
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [Job, WeakThis, Code = MoveTemp(Code)]() mutable
+        {
+            UAICodeGeneratorWidget* Widget = WeakThis.Get();
+            if (Widget && !Job->bCancelled && Widget->ActiveJob == Job)
+            {
+                Widget->OnGenerationFinished(MoveTemp(Code));
+            }
+        });
+    };
+
+    // Chained after the cancelled one, so waiting for the latest task waits for all of them
+    GenerationTask = GenerationTask.IsValid()
+        ? UE::Tasks::Launch(TEXT("AICodeGeneratorWidget"), MoveTemp(Generate), UE::Tasks::Prerequisites(GenerationTask))
+        : UE::Tasks::Launch(TEXT("AICodeGeneratorWidget"), MoveTemp(Generate));
+}
+
+void UAICodeGeneratorWidget::CancelGeneration()
+{
+    if (!ActiveJob)
+    {
+        return;
+    }
+
+    // The task may still finish its current step, its result is dropped
+    ActiveJob->bCancelled = true;
+    ActiveJob.Reset();
+
+    SetProgressVisible(false);
+    ShowStatus(TEXT("Code generation cancelled"));
+}
+
+bool UAICodeGeneratorWidget::IsGenerating() const
+{
+    return ActiveJob.IsValid();
+}
+
+void UAICodeGeneratorWidget::OnGenerationFinished(FGeneratedCode&& Code)
+{
+    ActiveJob.Reset();
+    SetProgressVisible(false);
+
+    CurrentCode = MoveTemp(Code);
+    UpdateUI();
+    
+    if (CurrentCode.bSuccess)
+    {
+        ShowStatus(FString::Printf(TEXT("Code generated successfully for %s!"), *CurrentCode.FileName));
+    }
+    else
+    {
+        ShowStatus(FString::Printf(TEXT("Code generation failed: %s"), *CurrentCode.ErrorMessage), true);
+    }
+}
+
+void UAICodeGeneratorWidget::SaveGeneratedCode()
+{
+    if (!CurrentCode.bSuccess)
+    {
+        ShowStatus(TEXT("No valid code to save"), true);
+        return;
+    }
+    
+    FString SavePath = GetDefaultSavePath();
+    if (CodeGenerator)
+    {
+        // The files are written in the background, the status follows once they are
+        ShowStatus(FString::Printf(TEXT("Saving code to %s..."), *SavePath));
+
+        TWeakObjectPtr<UAICodeGeneratorWidget> WeakThis(this);
+        CodeGenerator->SaveGeneratedCode(CurrentCode, SavePath, [WeakThis, SavePath](bool bSaved)
+        {
+            if (UAICodeGeneratorWidget* Widget = WeakThis.Get())
+            {
+                Widget->ShowStatus(bSaved ? FString::Printf(TEXT("Code saved to %s"), *SavePath)
+                                          : FString::Printf(TEXT("Failed to save code to %s"), *SavePath), !bSaved);
+            }
+        });
+    }
+}
+
+void UAICodeGeneratorWidget::ClearAll()
+{
+    if (RequestTextBox)
+    {
+        RequestTextBox->SetText(FText::GetEmpty());
+    }
+    
+    CancelGeneration();
+    
+    // Cleared unconditionally, the boxes may hold edits the displayed copies don't know about
+    if (HeaderCodeBox)
+    {
+        HeaderCodeBox->SetText(FText::GetEmpty());
+    }
+    
+    if (SourceCodeBox)
+    {
+        SourceCodeBox->SetText(FText::GetEmpty());
+    }
+    
+    DisplayedHeaderCode.Reset();
+    DisplayedSourceCode.Reset();
+    CurrentCode = FGeneratedCode();
+    UpdateUI();
+    ShowStatus(TEXT("Cleared all content"));
+}
+
+void UAICodeGeneratorWidget::LoadExampleRequest(const FString& ExampleType)
+{
+    FString ExampleRequest;
+    
+    if (ExampleType == TEXT("Character"))
+    {
+        ExampleRequest = TEXT("Create a guard character that patrols between waypoints and chases enemies when detected");
+    }
+    else if (ExampleType == TEXT("Task"))
+    {
+        ExampleRequest = TEXT("Create a behavior tree task that makes the AI search for cover when health is low");
+    }
+    else if (ExampleType == TEXT("Controller"))
+    {
+        ExampleRequest = TEXT("Create an AI controller with advanced perception and decision making");
+    }
+    
+    if (RequestTextBox && !ExampleRequest.IsEmpty())
+    {
+        RequestTextBox->SetText(FText::FromString(ExampleRequest));
+        ShowStatus(FString::Printf(TEXT("Loaded example: %s"), *ExampleType));
+    }
+}
+
+void UAICodeGeneratorWidget::UpdateUI()
+{
+    SetCodeBoxText(HeaderCodeBox, CurrentCode.HeaderCode, DisplayedHeaderCode);
+    SetCodeBoxText(SourceCodeBox, CurrentCode.SourceCode, DisplayedSourceCode);
+    
+    // Enable/disable save button based on code validity
+    if (SaveButton)
+    {
+        SaveButton->SetIsEnabled(CurrentCode.bSuccess);
+    }
+}
+
+void UAICodeGeneratorWidget::SetCodeBoxText(UMultiLineEditableTextBox* CodeBox, const FString& Code, FString& DisplayedCode)
+{
+    if (!CodeBox || Code.Equals(DisplayedCode, ESearchCase::CaseSensitive))
+    {
+        return;
+    }
+
+    // After SetText, which raises OnTextChanged for our own update too
+    CodeBox->SetText(FText::FromString(Code));
+    DisplayedCode = Code;
+}
+
+void UAICodeGeneratorWidget::SetProgressVisible(bool bVisible)
+{
+    if (GenerationProgressBar)
+    {
+        GenerationProgressBar->SetVisibility(bVisible ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
+        GenerationProgressBar->SetPercent(0.0f);
+    }
+
+    if (CancelButton)
+    {
+        CancelButton->SetIsEnabled(bVisible);
+    }
+
+    DisplayedProgress = 0.0f;
+}
+
+void UAICodeGeneratorWidget::ShowStatus(const FString& Message, bool bIsError)
+{
+    if (StatusText)
+    {
+        StatusText->SetText(FText::FromString(Message));
+        
+        // You could change text color based on error state
+        FLinearColor TextColor = bIsError ? FLinearColor::Red : FLinearColor::White;
+        StatusText->SetColorAndOpacity(FSlateColor(TextColor));
+    }
+    
+    UE_LOG(LogAICodeGen, Log, TEXT("Status: %s"), *Message);
+}
+
+FString UAICodeGeneratorWidget::GetDefaultSavePath() const
+{
+    return FPaths::ProjectDir() / TEXT("Source") / TEXT("Generated");
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+// AICodeTemplate.cpp - Template compiler and renderer
+#include "AICodeTemplate.h"
+
+namespace AICodeTemplate
+{
+    bool IsIdentifierChar(TCHAR Char)
+    {
+        return FChar::IsAlnum(Char) || Char == TEXT('_');
+    }
+
+    // Length of the {{Name}} placeholder starting at Start, 0 if there is none
+    int32 MatchPlaceholder(FStringView Source, int32 Start, FStringView& OutName)
+    {
+        if (!Source.RightChop(Start).StartsWith(TEXT("{{")))
+        {
+            return 0;
+        }
+
+        int32 NameEnd = Start + 2;
+        while (NameEnd < Source.Len() && IsIdentifierChar(Source[NameEnd]))
+        {
+            NameEnd++;
+        }
+
+        if (NameEnd == Start + 2 || !Source.RightChop(NameEnd).StartsWith(TEXT("}}")))
+        {
+            return 0;
+        }
+
+        OutName = Source.Mid(Start + 2, NameEnd - Start - 2);
+        return NameEnd + 2 - Start;
+    }
+}
+
+const FStringView* FAICodeTemplateArgs::Find(FName Name) const
+{
+    for (const TPair<FName, FStringView>& Value : Values)
+    {
+        if (Value.Key == Name)
+        {
+            return &Value.Value;
+        }
+    }
+
+    return nullptr;
+}
+
+void FAICodeTemplate::Compile(FStringView Source)
+{
+    Literals.Reset(Source.Len());
+    Segments.Reset();
+    Variables.Reset();
+
+    int32 LiteralStart = 0;
+    int32 Index = 0;
+
+    while (Index < Source.Len())
+    {
+        FStringView Name;
+        const int32 PlaceholderLen = Source[Index] == TEXT('{') ? AICodeTemplate::MatchPlaceholder(Source, Index, Name) : 0;
+        if (PlaceholderLen == 0)
+        {
+            Index++;
+            continue;
+        }
+
+        AddLiteral(Source.Mid(LiteralStart, Index - LiteralStart));
+
+        FSegment& Segment = Segments.AddDefaulted_GetRef();
+        Segment.VariableIndex = Variables.AddUnique(FName(Name));
+
+        Index += PlaceholderLen;
+        LiteralStart = Index;
+    }
+
+    AddLiteral(Source.Mid(LiteralStart));
+    Literals.Shrink();
+}
+
+void FAICodeTemplate::AddLiteral(FStringView Text)
+{
+    if (Text.IsEmpty())
+    {
+        return;
+    }
+
+    FSegment& Segment = Segments.AddDefaulted_GetRef();
+    Segment.Start = Literals.Len();
+    Segment.Len = Text.Len();
+    Literals.Append(Text);
+}
+
+void FAICodeTemplate::Render(const FAICodeTemplateArgs& Args, FStringBuilderBase& Builder) const
+{
+    // Bind each variable once, not once per occurrence
+    TArray<FStringView, TInlineAllocator<8>> Bound;
+    Bound.Reserve(Variables.Num());
+
+    for (const FName& Variable : Variables)
+    {
+        const FStringView* Value = Args.Find(Variable);
+        Bound.Add(Value ? *Value : FStringView());
+    }
+
+    const FStringView LiteralView(Literals);
+    for (const FSegment& Segment : Segments)
+    {
+        if (Segment.VariableIndex == INDEX_NONE)
+        {
+            Builder.Append(LiteralView.Mid(Segment.Start, Segment.Len));
+        }
+        else
+        {
+            Builder.Append(Bound[Segment.VariableIndex]);
+        }
+    }
+}
+
+FString FAICodeTemplate::Render(const FAICodeTemplateArgs& Args) const
+{
+    // Generated classes fit the inline buffer, so the returned string is the only allocation
+    TStringBuilder<4096> Builder;
+    Render(Args, Builder);
+    return FString(Builder.ToView());
+}
@@ -0,0 +1,142 @@
+// AIKeywordMatcher.cpp - Aho-Corasick automaton implementation
+#include "AIKeywordMatcher.h"
+
+FAIKeywordMatcher::FAIKeywordMatcher()
+{
+    Reset();
+}
+
+void FAIKeywordMatcher::Reset()
+{
+    Nodes.Reset();
+    PatternLengths.Reset();
+    bBuilt = false;
+
+    // Root
+    AddNode();
+}
+
+int32 FAIKeywordMatcher::AddNode()
+{
+    FNode& Node = Nodes.AddDefaulted_GetRef();
+    for (int32& Next : Node.Next)
+    {
+        Next = INDEX_NONE;
+    }
+    return Nodes.Num() - 1;
+}
+
+int32 FAIKeywordMatcher::GetSymbol(TCHAR Char)
+{
+    if (Char >= TEXT('a') && Char <= TEXT('z'))
+    {
+        return Char - TEXT('a');
+    }
+    if (Char >= TEXT('A') && Char <= TEXT('Z'))
+    {
+        return Char - TEXT('A');
+    }
+    if (Char >= TEXT('0') && Char <= TEXT('9'))
+    {
+        return 26 + (Char - TEXT('0'));
+    }
+
+    return FChar::IsWhitespace(Char) ? 36 : 37;
+}
+
+int32 FAIKeywordMatcher::AddPattern(FStringView Pattern)
+{
+    check(!bBuilt);
+
+    if (Pattern.IsEmpty())
+    {
+        return INDEX_NONE;
+    }
+
+    int32 Node = 0;
+    for (TCHAR Char : Pattern)
+    {
+        const int32 Symbol = GetSymbol(Char);
+        if (Nodes[Node].Next[Symbol] == INDEX_NONE)
+        {
+            const int32 Child = AddNode();
+            Nodes[Node].Next[Symbol] = Child;
+        }
+        Node = Nodes[Node].Next[Symbol];
+    }
+
+    if (Nodes[Node].Pattern == INDEX_NONE)
+    {
+        Nodes[Node].Pattern = PatternLengths.Add(Pattern.Len());
+    }
+
+    return Nodes[Node].Pattern;
+}
+
+void FAIKeywordMatcher::Build()
+{
+    TArray<int32> Failure;
+    Failure.SetNumZeroed(Nodes.Num());
+
+    TArray<int32> Queue;
+    Queue.Reserve(Nodes.Num());
+
+    // Depth one nodes fail to the root, missing root transitions loop back to it
+    for (int32& Next : Nodes[0].Next)
+    {
+        if (Next == INDEX_NONE)
+        {
+            Next = 0;
+        }
+        else
+        {
+            Queue.Add(Next);
+        }
+    }
+
+    // Breadth first, so every failure target is complete before it is used
+    for (int32 QueueIndex = 0; QueueIndex < Queue.Num(); QueueIndex++)
+    {
+        const int32 Node = Queue[QueueIndex];
+        const int32 NodeFailure = Failure[Node];
+
+        for (int32 Symbol = 0; Symbol < NumSymbols; Symbol++)
+        {
+            const int32 Child = Nodes[Node].Next[Symbol];
+            if (Child == INDEX_NONE)
+            {
+                Nodes[Node].Next[Symbol] = Nodes[NodeFailure].Next[Symbol];
+                continue;
+            }
+
+            const int32 ChildFailure = Nodes[NodeFailure].Next[Symbol];
+            Failure[Child] = ChildFailure;
+            Nodes[Child].OutputLink = Nodes[ChildFailure].Pattern != INDEX_NONE ? ChildFailure : Nodes[ChildFailure].OutputLink;
+            Queue.Add(Child);
+        }
+    }
+
+    bBuilt = true;
+}
+
+void FAIKeywordMatcher::Scan(FStringView Text, TArray<FAIKeywordMatch>& OutMatches) const
+{
+    check(bBuilt);
+
+    int32 State = 0;
+    for (int32 Index = 0; Index < Text.Len(); Index++)
+    {
+        State = Nodes[State].Next[GetSymbol(Text[Index])];
+
+        int32 Node = Nodes[State].Pattern != INDEX_NONE ? State : Nodes[State].OutputLink;
+        while (Node != INDEX_NONE)
+        {
+            FAIKeywordMatch& Match = OutMatches.AddDefaulted_GetRef();
+            Match.PatternIndex = Nodes[Node].Pattern;
+            Match.Len = PatternLengths[Match.PatternIndex];
+            Match.Start = Index + 1 - Match.Len;
+
+            Node = Nodes[Node].OutputLink;
+        }
+    }
+}
@@ -0,0 +1,158 @@
+// AIBuilderStateHistoryCommandlet.cpp - State history replay implementation
+#include "Commandlets/AIBuilderStateHistoryCommandlet.h"
+#include "Components/AIBuilderStateHistory.h"
+#include "Components/AIBuilderStateMachine.h"
+#include "AIBuilder.h"
+
+namespace AIBuilderStateHistoryCommandlet
+{
+    FString GetStateName(uint8 State)
+    {
+        return StaticEnum<EAIBuilderState>()->GetNameStringByValue(State);
+    }
+
+    FString DescribeReason(const FAIBuilderTransitionRecord& Record)
+    {
+        if (Record.Reason == static_cast<uint8>(EAIBuilderTransitionReason::Manual))
+        {
+            return TEXT("Manual");
+        }
+
+        const UEnum* ConditionEnum = StaticEnum<EAIBuilderConditionType>();
+
+        TArray<FString> Conditions;
+        for (int32 Bit = 0; Bit < 8; Bit++)
+        {
+            if (Record.ConditionMask & (1u << Bit))
+            {
+                Conditions.Add(ConditionEnum->GetNameStringByValue(Bit));
+            }
+        }
+
+        return Conditions.Num() > 0 ? FString::Printf(TEXT("Rule: %s"), *FString::Join(Conditions, TEXT(" + "))) : TEXT("Rule");
+    }
+
+    // A flap is a transition straight back to the previous state within the window
+    struct FFlapStats
+    {
+        int32 Count = 0;
+        float DistanceSum = 0.0f;
+        int32 NumDistances = 0;
+    };
+}
+
+UAIBuilderStateHistoryCommandlet::UAIBuilderStateHistoryCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UAIBuilderStateHistoryCommandlet::Main(const FString& Params)
+{
+    using namespace AIBuilderStateHistoryCommandlet;
+
+    FString Filename;
+    if (!FParse::Value(*Params, TEXT("File="), Filename))
+    {
+        UE_LOG(LogAIBuilder, Error, TEXT("Usage: -run=AIBuilderStateHistory -File=<dump> [-Agent=<name>] [-FlapWindow=<seconds>] [-SummaryOnly]"));
+        return 1;
+    }
+
+    FString AgentFilter;
+    FParse::Value(*Params, TEXT("Agent="), AgentFilter);
+
+    float FlapWindow = 2.0f;
+    FParse::Value(*Params, TEXT("FlapWindow="), FlapWindow);
+
+    const bool bSummaryOnly = FParse::Param(*Params, TEXT("SummaryOnly"));
+
+    FAIBuilderStateHistoryDump Dump;
+    if (!Dump.LoadFromFile(Filename))
+    {
+        UE_LOG(LogAIBuilder, Error, TEXT("%s is not a readable state history dump"), *Filename);
+        return 1;
+    }
+
+    UE_LOG(LogAIBuilder, Display, TEXT("%s: %d agents, captured at %.2f s"), *Filename, Dump.Agents.Num(), Dump.CaptureTime);
+
+    // Keyed by the unordered state pair, low state in the low byte
+    TMap<uint16, FFlapStats> TotalFlaps;
+    int32 NumFlappingAgents = 0;
+
+    for (const FAIBuilderStateHistoryDump::FAgent& Agent : Dump.Agents)
+    {
+        if (!AgentFilter.IsEmpty() && !Agent.Name.Contains(AgentFilter))
+        {
+            continue;
+        }
+
+        if (!bSummaryOnly)
+        {
+            UE_LOG(LogAIBuilder, Display, TEXT("%s: %u transitions, last %d kept"), *Agent.Name, Agent.NumTransitions, Agent.Records.Num());
+        }
+
+        TMap<uint16, FFlapStats> AgentFlaps;
+
+        for (int32 i = 0; i < Agent.Records.Num(); i++)
+        {
+            const FAIBuilderTransitionRecord& Record = Agent.Records[i];
+
+            if (!bSummaryOnly)
+            {
+                const FString* TargetName = Dump.TargetNames.Find(Record.TargetId);
+                const FString Target = TargetName ? FString::Printf(TEXT(", target %s at %.1f"), **TargetName, Record.TargetDistance) : FString();
+
+                UE_LOG(LogAIBuilder, Display, TEXT("  %8.2f  %s -> %s  [%s]%s"), Record.Time, *GetStateName(Record.OldState),
+                       *GetStateName(Record.NewState), *DescribeReason(Record), *Target);
+            }
+
+            if (i == 0)
+            {
+                continue;
+            }
+
+            const FAIBuilderTransitionRecord& Previous = Agent.Records[i - 1];
+            if (Record.NewState != Previous.OldState || Record.OldState != Previous.NewState || Record.Time - Previous.Time > FlapWindow)
+            {
+                continue;
+            }
+
+            const uint16 Pair = static_cast<uint16>(FMath::Min(Record.OldState, Record.NewState) | (FMath::Max(Record.OldState, Record.NewState) << 8));
+            FFlapStats& Stats = AgentFlaps.FindOrAdd(Pair);
+            Stats.Count++;
+
+            if (Record.TargetDistance >= 0.0f)
+            {
+                Stats.DistanceSum += Record.TargetDistance;
+                Stats.NumDistances++;
+            }
+        }
+
+        NumFlappingAgents += AgentFlaps.Num() > 0;
+
+        for (const TPair<uint16, FFlapStats>& Flap : AgentFlaps)
+        {
+            const FString StateA = GetStateName(Flap.Key & 0xFF);
+            const FString StateB = GetStateName(Flap.Key >> 8);
+
+            UE_LOG(LogAIBuilder, Warning, TEXT("%s flaps %s <-> %s %d times within %.2f s%s"), *Agent.Name, *StateA, *StateB, Flap.Value.Count, FlapWindow,
+                   Flap.Value.NumDistances > 0 ? *FString::Printf(TEXT(", average target distance %.1f"), Flap.Value.DistanceSum / Flap.Value.NumDistances) : TEXT(""));
+
+            FFlapStats& Total = TotalFlaps.FindOrAdd(Flap.Key);
+            Total.Count += Flap.Value.Count;
+            Total.DistanceSum += Flap.Value.DistanceSum;
+            Total.NumDistances += Flap.Value.NumDistances;
+        }
+    }
+
+    UE_LOG(LogAIBuilder, Display, TEXT("%d agents flapping"), NumFlappingAgents);
+
+    for (const TPair<uint16, FFlapStats>& Flap : TotalFlaps)
+    {
+        UE_LOG(LogAIBuilder, Display, TEXT("  %s <-> %s: %d flaps%s"), *GetStateName(Flap.Key & 0xFF), *GetStateName(Flap.Key >> 8), Flap.Value.Count,
+               Flap.Value.NumDistances > 0 ? *FString::Printf(TEXT(", average target distance %.1f"), Flap.Value.DistanceSum / Flap.Value.NumDistances) : TEXT(""));
+    }
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+// AIBuilderDetectionTable.cpp - Detection table implementation
+#include "Components/AIBuilderDetectionTable.h"
+#include "GameFramework/Actor.h"
+
+FAISensorData* FAIDetectionTable::Find(const AActor* Actor)
+{
+    const int32* Index = IndexByActor.Find(TObjectKey<AActor>(Actor));
+    return Index ? &Entries[*Index] : nullptr;
+}
+
+const FAISensorData* FAIDetectionTable::Find(const AActor* Actor) const
+{
+    const int32* Index = IndexByActor.Find(TObjectKey<AActor>(Actor));
+    return Index ? &Entries[*Index] : nullptr;
+}
+
+bool FAIDetectionTable::Contains(const AActor* Actor) const
+{
+    return IndexByActor.Contains(TObjectKey<AActor>(Actor));
+}
+
+int32 FAIDetectionTable::FindOrAdd(AActor* Actor, bool& bOutAdded)
+{
+    const TObjectKey<AActor> Key(Actor);
+    if (const int32* Index = IndexByActor.Find(Key))
+    {
+        bOutAdded = false;
+        return *Index;
+    }
+
+    bOutAdded = true;
+    const int32 NewIndex = Entries.Num();
+    IndexByActor.Add(Key, NewIndex);
+    Keys.Add(Key);
+
+    FAISensorData& NewData = Entries.AddDefaulted_GetRef();
+    NewData.DetectedActor = Actor;
+    return NewIndex;
+}
+
+void FAIDetectionTable::OnConfidenceRaised(int32 Index)
+{
+    if (bBestDirty)
+    {
+        return;
+    }
+
+    if (BestIndex == INDEX_NONE || Entries[Index].Confidence > Entries[BestIndex].Confidence)
+    {
+        BestIndex = Index;
+    }
+}
+
+const FAISensorData* FAIDetectionTable::GetBest() const
+{
+    if (bBestDirty)
+    {
+        BestIndex = INDEX_NONE;
+        for (int32 i = 0; i < Entries.Num(); i++)
+        {
+            if (BestIndex == INDEX_NONE || Entries[i].Confidence > Entries[BestIndex].Confidence)
+            {
+                BestIndex = i;
+            }
+        }
+        bBestDirty = false;
+    }
+
+    return BestIndex != INDEX_NONE ? &Entries[BestIndex] : nullptr;
+}
+
+void FAIDetectionTable::RemoveAtSwap(int32 Index)
+{
+    check(Entries.IsValidIndex(Index));
+
+    IndexByActor.Remove(Keys[Index]);
+
+    const int32 LastIndex = Entries.Num() - 1;
+    if (Index != LastIndex)
+    {
+        IndexByActor[Keys[LastIndex]] = Index;
+    }
+
+    if (Index == BestIndex)
+    {
+        bBestDirty = true;
+    }
+    else if (LastIndex == BestIndex)
+    {
+        BestIndex = Index;
+    }
+
+    Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Keys.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void FAIDetectionTable::Reset()
+{
+    Entries.Reset();
+    Keys.Reset();
+    IndexByActor.Reset();
+    BestIndex = INDEX_NONE;
+    bBestDirty = false;
+}
@@ -2,20 +2,64 @@
 #include "Components/AIBuilderSensorComponent.h"
 #include "Engine/World.h"
 #include "DrawDebugHelpers.h"
+#include "Subsystems/AIBuilderSpatialGridSubsystem.h"
+#include "Subsystems/AIBuilderSensorSchedulerSubsystem.h"
+#include "Subsystems/AIBuilderNoiseSubsystem.h"
 #include "AIBuilder.h"
+#include "AIBuilderStats.h"
 
 UAIBuilderSensorComponent::UAIBuilderSensorComponent()
 {
     PrimaryComponentTick.bCanEverTick = true;
     LastUpdateTime = 0.0f;
+    SpatialGrid = nullptr;
+    SensorScheduler = nullptr;
+    NoiseBus = nullptr;
+    NextSightTraceId = 0;
 }
 
 void UAIBuilderSensorComponent::BeginPlay()
 {
     Super::BeginPlay();
+    SpatialGrid = GetWorld()->GetSubsystem<UAIBuilderSpatialGridSubsystem>();
+    NoiseBus = GetWorld()->GetSubsystem<UAIBuilderNoiseSubsystem>();
+    SightTraceDelegate.BindUObject(this, &UAIBuilderSensorComponent::OnSightTraceCompleted);
+
+    if (bUseSensorScheduler)
+    {
+        SensorScheduler = GetWorld()->GetSubsystem<UAIBuilderSensorSchedulerSubsystem>();
+    }
+
+    if (SensorScheduler)
+    {
+        SensorScheduler->RegisterSensor(this);
+    }
+    else
+    {
+        // Ticking on our own, still start at a random phase to avoid synchronized updates
+        LastUpdateTime = FMath::FRandRange(0.0f, UpdateFrequency);
+    }
+
     UE_LOG(LogAIBuilder, Log, TEXT("AI Sensor Component initialized for %s"), *GetOwner()->GetName());
 }
 
+void UAIBuilderSensorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // In-flight traces still complete, but their results are dropped
+    PendingSightTraces.Empty();
+
+    DEC_DWORD_STAT_BY(STAT_AIBuilder_ActiveDetections, Detections.Num());
+    Detections.Reset();
+
+    if (SensorScheduler)
+    {
+        SensorScheduler->UnregisterSensor(this);
+        SensorScheduler = nullptr;
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void UAIBuilderSensorComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
@@ -24,117 +68,191 @@ void UAIBuilderSensorComponent::TickComponent(float DeltaTime, ELevelTick TickTy
     
     if (LastUpdateTime >= UpdateFrequency)
     {
-        if (bEnableSightSensor)
-        {
-            UpdateSightSensor(DeltaTime);
-        }
-        
-        if (bEnableHearingSensor)
-        {
-            UpdateHearingSensor(DeltaTime);
-        }
-        
-        if (bEnableTouchSensor)
-        {
-            UpdateTouchSensor(DeltaTime);
-        }
-        
-        RemoveOldDetections(DeltaTime);
+        UpdateSensors(LastUpdateTime);
         LastUpdateTime = 0.0f;
     }
 }
 
-void UAIBuilderSensorComponent::UpdateSightSensor(float DeltaTime)
+void UAIBuilderSensorComponent::UpdateSensors(float DeltaTime, const FAISensorLODTier* LODTier)
+{
+    BeginSensorUpdate(DeltaTime, LODTier);
+    EvaluateSensorUpdate();
+    FinishSensorUpdate();
+}
+
+void UAIBuilderSensorComponent::BeginSensorUpdate(float DeltaTime, const FAISensorLODTier* LODTier)
 {
+    PendingUpdate.DeltaTime = DeltaTime;
+    PendingUpdate.bSight = bEnableSightSensor && (!LODTier || LODTier->bEnableSight);
+    PendingUpdate.bHearing = bEnableHearingSensor && (!LODTier || LODTier->bEnableHearing);
+    PendingUpdate.bTouch = bEnableTouchSensor && (!LODTier || LODTier->bEnableTouch);
+
+    SightResults.Reset();
+
+    if (PendingUpdate.bSight)
+    {
+        GatherSightCandidates();
+    }
+}
+
+void UAIBuilderSensorComponent::EvaluateSensorUpdate()
+{
+    if (PendingUpdate.bSight)
+    {
+        EvaluateSightCandidates();
+    }
+}
+
+void UAIBuilderSensorComponent::FinishSensorUpdate()
+{
+    const float DeltaTime = PendingUpdate.DeltaTime;
+
+    if (PendingUpdate.bSight)
+    {
+        ApplySightResults();
+    }
+    
+    if (PendingUpdate.bHearing)
+    {
+        UpdateHearingSensor(DeltaTime);
+    }
+    
+    if (PendingUpdate.bTouch)
+    {
+        UpdateTouchSensor(DeltaTime);
+    }
+    
+    RemoveOldDetections(DeltaTime);
+    PendingUpdate = FPendingSensorUpdate();
+}
+
+void UAIBuilderSensorComponent::GatherSightCandidates()
+{
+    AIBUILDER_SCOPE_CYCLE_COUNTER(STAT_AIBuilder_SightCandidates);
+
+    CandidateScratch.Reset();
+    CandidatePositions.Reset();
+
     if (!GetOwner())
         return;
 
-    FVector OwnerLocation = GetOwner()->GetActorLocation();
-    FVector OwnerForward = GetOwner()->GetActorForwardVector();
+    // Snapshot our view and every pawn in sight range so evaluation needs no actor access
+    SightCone = FAIBuilderVisionCone(GetOwner()->GetActorLocation(), GetOwner()->GetActorForwardVector(), SightAngle, SightRange);
+    GatherCandidates(SightRange, CandidateScratch);
 
-    // Get all actors in sight range
-    TArray<FOverlapResult> OverlapResults;
-    FCollisionQueryParams QueryParams;
-    QueryParams.AddIgnoredActor(GetOwner());
+    for (const FAISensorCandidate& Candidate : CandidateScratch)
+    {
+        CandidatePositions.Add(Candidate.Location);
+    }
+}
 
-    bool bHit = GetWorld()->OverlapMultiByChannel(
-        OverlapResults,
-        OwnerLocation,
-        FQuat::Identity,
-        ECC_Pawn,
-        FCollisionShape::MakeSphere(SightRange),
-        QueryParams
-    );
+void UAIBuilderSensorComponent::EvaluateSightCandidates()
+{
+    AIBUILDER_SCOPE_CYCLE_COUNTER(STAT_AIBuilder_SightCone);
 
-    if (bHit)
+    // Runs on worker threads, only reads the snapshot and writes SightResults
+    VisibleCandidateIndices.Reset();
+    SightResults.Reset();
+
+    // Cone and range rejection for four candidates at a time
+    SightCone.FilterTargets(CandidatePositions, VisibleCandidateIndices);
+
+    for (int32 CandidateIndex : VisibleCandidateIndices)
     {
-        for (const FOverlapResult& Result : OverlapResults)
-        {
-            if (AActor* DetectedActor = Result.GetActor())
-            {
-                FVector ToTarget = DetectedActor->GetActorLocation() - OwnerLocation;
-                float Distance = ToTarget.Size();
-                ToTarget.Normalize();
-
-                // Check if within sight angle
-                float DotProduct = FVector::DotProduct(OwnerForward, ToTarget);
-                float AngleRadians = FMath::Acos(DotProduct);
-                float AngleDegrees = FMath::RadiansToDegrees(AngleRadians);
-
-                if (AngleDegrees <= SightAngle * 0.5f)
-                {
-                    FVector HitLocation;
-                    if (CanSeeActor(DetectedActor, HitLocation))
-                    {
-                        float Confidence = CalculateSightConfidence(DetectedActor, Distance);
-                        AddOrUpdateDetection(DetectedActor, ESensorType::Sight, Confidence, DetectedActor->GetActorLocation());
-                    }
-                }
-            }
-        }
+        const FAISensorCandidate& Candidate = CandidateScratch[CandidateIndex];
+        float Distance = FVector::Dist(FVector(SightCone.Origin), Candidate.Location);
+        SightResults.Add({ CandidateIndex, CalculateSightConfidence(Candidate.Actor, Distance) });
     }
 }
 
-void UAIBuilderSensorComponent::UpdateHearingSensor(float DeltaTime)
+void UAIBuilderSensorComponent::ApplySightResults()
 {
+    AIBUILDER_SCOPE_CYCLE_COUNTER(STAT_AIBuilder_SightTraces);
+
     if (!GetOwner())
         return;
 
-    FVector OwnerLocation = GetOwner()->GetActorLocation();
-
-    // Process recent noise events
-    for (int32 i = RecentNoiseEvents.Num() - 1; i >= 0; i--)
+    for (const FSightResult& Result : SightResults)
     {
-        const FNoiseEvent& NoiseEvent = RecentNoiseEvents[i];
-        float EventAge = GetWorld()->GetTimeSeconds() - NoiseEvent.TimeStamp;
+        const FAISensorCandidate& Candidate = CandidateScratch[Result.CandidateIndex];
+        AActor* DetectedActor = Candidate.Actor;
+        if (!IsValid(DetectedActor))
+        {
+            continue;
+        }
 
-        if (EventAge > 2.0f) // Remove old noise events
+        if (bUseAsyncSightTraces)
         {
-            RecentNoiseEvents.RemoveAt(i);
+            QueueSightTrace(DetectedActor, Candidate.Location, Result.Confidence);
             continue;
         }
 
-        float Distance = FVector::Dist(OwnerLocation, NoiseEvent.Location);
-        if (Distance <= HearingRange)
+        FVector HitLocation;
+        if (CanSeeActor(DetectedActor, HitLocation))
         {
-            float Confidence = CalculateHearingConfidence(NoiseEvent.Location, NoiseEvent.Volume, Distance);
-            
-            if (NoiseEvent.Instigator)
-            {
-                AddOrUpdateDetection(NoiseEvent.Instigator, ESensorType::Hearing, Confidence, NoiseEvent.Location);
-            }
+            AddOrUpdateDetection(DetectedActor, ESensorType::Sight, Result.Confidence, Candidate.Location);
         }
     }
+
+    SightResults.Reset();
+}
+
+void UAIBuilderSensorComponent::UpdateHearingSensor(float DeltaTime)
+{
+    AIBUILDER_SCOPE_CYCLE_COUNTER(STAT_AIBuilder_Hearing);
+
+    if (!GetOwner() || !NoiseBus)
+        return;
+
+    FVector OwnerLocation = GetOwner()->GetActorLocation();
+
+    // Only events in the cells under our hearing range are visited
+    NoiseBus->QueryNoise(OwnerLocation, HearingRange, [this, &OwnerLocation](const FAIBuilderNoiseEvent& NoiseEvent)
+    {
+        AActor* Instigator = NoiseEvent.Instigator.Get();
+        if (!Instigator || Instigator == GetOwner())
+        {
+            return;
+        }
+
+        float Distance = FVector::Dist(OwnerLocation, NoiseEvent.Location);
+        float Confidence = CalculateHearingConfidence(NoiseEvent.Location, NoiseEvent.Volume, Distance);
+        AddOrUpdateDetection(Instigator, ESensorType::Hearing, Confidence, NoiseEvent.Location);
+    });
 }
 
 void UAIBuilderSensorComponent::UpdateTouchSensor(float DeltaTime)
 {
+    AIBUILDER_SCOPE_CYCLE_COUNTER(STAT_AIBuilder_Touch);
+
     if (!GetOwner())
         return;
 
     FVector OwnerLocation = GetOwner()->GetActorLocation();
 
-    // Get all actors in touch range
+    // Get all pawns in touch range
+    GatherCandidates(TouchRange, CandidateScratch);
+
+    for (const FAISensorCandidate& Candidate : CandidateScratch)
+    {
+        // Touch sensor has high confidence when in range
+        AddOrUpdateDetection(Candidate.Actor, ESensorType::Touch, 1.0f, Candidate.Location);
+    }
+}
+
+void UAIBuilderSensorComponent::GatherCandidates(float Range, TArray<FAISensorCandidate>& OutCandidates)
+{
+    OutCandidates.Reset();
+
+    FVector OwnerLocation = GetOwner()->GetActorLocation();
+
+    if (SpatialGrid)
+    {
+        SpatialGrid->QuerySphere(OwnerLocation, Range, GetOwner(), OutCandidates);
+        return;
+    }
+
+    // No shared grid in this world, fall back to a physics overlap
     TArray<FOverlapResult> OverlapResults;
     FCollisionQueryParams QueryParams;
     QueryParams.AddIgnoredActor(GetOwner());
@@ -144,7 +262,7 @@ void UAIBuilderSensorComponent::UpdateTouchSensor(float DeltaTime)
         OwnerLocation,
         FQuat::Identity,
         ECC_Pawn,
-        FCollisionShape::MakeSphere(TouchRange),
+        FCollisionShape::MakeSphere(Range),
         QueryParams
     );
 
@@ -154,8 +272,7 @@ void UAIBuilderSensorComponent::UpdateTouchSensor(float DeltaTime)
         {
             if (AActor* DetectedActor = Result.GetActor())
             {
-                // Touch sensor has high confidence when in range
-                AddOrUpdateDetection(DetectedActor, ESensorType::Touch, 1.0f, DetectedActor->GetActorLocation());
+                OutCandidates.Add({ DetectedActor, DetectedActor->GetActorLocation() });
             }
         }
     }
@@ -174,6 +291,8 @@ bool UAIBuilderSensorComponent::CanSeeActor(AActor* Actor, FVector& OutHitLocati
     QueryParams.AddIgnoredActor(GetOwner());
     QueryParams.AddIgnoredActor(Actor);
 
+    INC_DWORD_STAT(STAT_AIBuilder_SightTracesIssued);
+
     bool bHit = GetWorld()->LineTraceSingleByChannel(
         HitResult,
         StartLocation,
@@ -186,6 +305,58 @@ bool UAIBuilderSensorComponent::CanSeeActor(AActor* Actor, FVector& OutHitLocati
     return !bHit; // No obstruction means we can see the actor
 }
 
+void UAIBuilderSensorComponent::QueueSightTrace(AActor* Actor, const FVector& TargetLocation, float Confidence)
+{
+    FCollisionQueryParams QueryParams;
+    QueryParams.AddIgnoredActor(GetOwner());
+    QueryParams.AddIgnoredActor(Actor);
+
+    // The world batches every async trace issued this frame and runs them off the game thread
+    const uint32 TraceId = NextSightTraceId++;
+    INC_DWORD_STAT(STAT_AIBuilder_SightTracesIssued);
+
+    GetWorld()->AsyncLineTraceByChannel(
+        EAsyncTraceType::Single,
+        GetOwner()->GetActorLocation(),
+        TargetLocation,
+        ECC_Visibility,
+        QueryParams,
+        FCollisionResponseParams::DefaultResponseParam,
+        &SightTraceDelegate,
+        TraceId
+    );
+
+    PendingSightTraces.Add(TraceId, { Actor, Confidence });
+}
+
+void UAIBuilderSensorComponent::OnSightTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+    AIBUILDER_SCOPE_CYCLE_COUNTER(STAT_AIBuilder_SightTraceResults);
+
+    FPendingSightTrace PendingTrace;
+    if (!PendingSightTraces.RemoveAndCopyValue(TraceDatum.UserData, PendingTrace))
+    {
+        return;
+    }
+
+    AActor* Actor = PendingTrace.Actor.Get();
+    if (!Actor || !GetOwner())
+    {
+        return;
+    }
+
+    // No blocking hit means the actor was visible when the trace was issued
+    const bool bBlocked = TraceDatum.OutHits.ContainsByPredicate([](const FHitResult& Hit)
+    {
+        return Hit.bBlockingHit;
+    });
+
+    if (!bBlocked)
+    {
+        AddOrUpdateDetection(Actor, ESensorType::Sight, PendingTrace.Confidence, TraceDatum.End);
+    }
+}
+
 float UAIBuilderSensorComponent::CalculateSightConfidence(AActor* Actor, float Distance) const
 {
     if (!Actor)
@@ -210,29 +381,22 @@ void UAIBuilderSensorComponent::AddOrUpdateDetection(AActor* Actor, ESensorType
     if (!Actor)
         return;
 
-    // Find existing detection
-    FAISensorData* ExistingData = DetectedActors.FindByPredicate([Actor](const FAISensorData& Data)
-    {
-        return Data.DetectedActor == Actor;
-    });
+    AIBUILDER_SCOPE_CYCLE_COUNTER(STAT_AIBuilder_DetectionTable);
 
-    if (ExistingData)
-    {
-        // Update existing detection
-        ExistingData->LastKnownLocation = Location;
-        ExistingData->DetectionTime = GetWorld()->GetTimeSeconds();
-        ExistingData->Confidence = FMath::Max(ExistingData->Confidence, Confidence);
-    }
-    else
+    bool bIsNewDetection = false;
+    const int32 Index = Detections.FindOrAdd(Actor, bIsNewDetection);
+    FAISensorData& Data = Detections[Index];
+
+    // New entries start at zero confidence, so this also covers the first detection
+    Data.LastKnownLocation = Location;
+    Data.DetectionTime = GetWorld()->GetTimeSeconds();
+    Data.Confidence = FMath::Max(Data.Confidence, Confidence);
+
+    Detections.OnConfidenceRaised(Index);
+
+    if (bIsNewDetection)
     {
-        // Add new detection
-        FAISensorData NewData;
-        NewData.DetectedActor = Actor;
-        NewData.LastKnownLocation = Location;
-        NewData.DetectionTime = GetWorld()->GetTimeSeconds();
-        NewData.Confidence = Confidence;
-        
-        DetectedActors.Add(NewData);
+        INC_DWORD_STAT(STAT_AIBuilder_ActiveDetections);
         OnActorDetected.Broadcast(Actor, SensorType, Confidence);
         
         UE_LOG(LogAIBuilder, Log, TEXT("%s detected %s via %s sensor"), 
@@ -244,17 +408,21 @@ void UAIBuilderSensorComponent::AddOrUpdateDetection(AActor* Actor, ESensorType
 
 void UAIBuilderSensorComponent::RemoveOldDetections(float DeltaTime)
 {
+    AIBUILDER_SCOPE_CYCLE_COUNTER(STAT_AIBuilder_DetectionTable);
+
     float CurrentTime = GetWorld()->GetTimeSeconds();
     
-    for (int32 i = DetectedActors.Num() - 1; i >= 0; i--)
+    // Walking backwards keeps swap-removal from skipping entries
+    for (int32 i = Detections.Num() - 1; i >= 0; i--)
     {
-        FAISensorData& Data = DetectedActors[i];
+        FAISensorData& Data = Detections[i];
         float Age = CurrentTime - Data.DetectionTime;
         
         if (Age > ForgetTime || !IsValid(Data.DetectedActor))
         {
             AActor* LostActor = Data.DetectedActor;
-            DetectedActors.RemoveAt(i);
+            Detections.RemoveAtSwap(i);
+            DEC_DWORD_STAT(STAT_AIBuilder_ActiveDetections);
             
             if (LostActor)
             {
@@ -268,46 +436,45 @@ void UAIBuilderSensorComponent::RemoveOldDetections(float DeltaTime)
 
 TArray<FAISensorData> UAIBuilderSensorComponent::GetDetectedActors() const
 {
-    return DetectedActors;
+    return Detections.GetEntries();
 }
 
 FAISensorData UAIBuilderSensorComponent::GetHighestConfidenceDetection() const
 {
-    FAISensorData BestDetection;
-    float HighestConfidence = -1.0f;
-    
-    for (const FAISensorData& Data : DetectedActors)
+    const FAISensorData* BestDetection = Detections.GetBest();
+    return BestDetection ? *BestDetection : FAISensorData();
+}
+
+TConstArrayView<FAISensorData> UAIBuilderSensorComponent::GetDetectionsView() const
+{
+    return Detections.GetEntries();
+}
+
+void UAIBuilderSensorComponent::ForEachDetection(TFunctionRef<void(const FAISensorData&)> Visitor) const
+{
+    for (const FAISensorData& Data : Detections.GetEntries())
     {
-        if (Data.Confidence > HighestConfidence)
-        {
-            HighestConfidence = Data.Confidence;
-            BestDetection = Data;
-        }
+        Visitor(Data);
     }
-    
-    return BestDetection;
+}
+
+const FAISensorData* UAIBuilderSensorComponent::GetBestDetection() const
+{
+    return Detections.GetBest();
 }
 
 bool UAIBuilderSensorComponent::HasDetectedActor(AActor* Actor) const
 {
-    return DetectedActors.ContainsByPredicate([Actor](const FAISensorData& Data)
-    {
-        return Data.DetectedActor == Actor;
-    });
+    return Detections.Contains(Actor);
 }
 
 void UAIBuilderSensorComponent::AddNoiseEvent(FVector Location, float Volume, AActor* Instigator)
 {
-    FNoiseEvent NoiseEvent;
-    NoiseEvent.Location = Location;
-    NoiseEvent.Volume = Volume;
-    NoiseEvent.TimeStamp = GetWorld()->GetTimeSeconds();
-    NoiseEvent.Instigator = Instigator;
-    
-    RecentNoiseEvents.Add(NoiseEvent);
-    
-    UE_LOG(LogAIBuilder, Log, TEXT("Noise event added at %s with volume %f"), 
-           *Location.ToString(), Volume);
+    // Noise goes onto the world bus so every listener in range can hear it
+    if (NoiseBus)
+    {
+        NoiseBus->ReportNoise(Location, Volume, Instigator);
+    }
 }
 
 void UAIBuilderSensorComponent::SetSensorEnabled(ESensorType SensorType, bool bEnabled)
@@ -0,0 +1,162 @@
+// AIBuilderStateHistory.cpp - Transition history snapshots, dumps and console command
+#include "Components/AIBuilderStateHistory.h"
+#include "Components/AIBuilderStateMachine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/UObjectIterator.h"
+#include "AIBuilder.h"
+
+namespace AIBuilderStateHistory
+{
+    constexpr uint32 Magic = 0x48424941; // "AIBH"
+    constexpr uint32 Version = 1;
+}
+
+int32 FAIBuilderStateHistory::Snapshot(TArray<FAIBuilderTransitionRecord>& OutRecords) const
+{
+    const uint32 End = NumWritten.load(std::memory_order_acquire);
+    const uint32 Begin = End > Capacity ? End - Capacity : 0;
+    const int32 FirstOut = OutRecords.Num();
+
+    for (uint32 Index = Begin; Index < End; Index++)
+    {
+        OutRecords.Add(Records[Index & (Capacity - 1)]);
+    }
+
+    // The writer may have lapped us while copying. Every slot it reached since, plus the one
+    // it may be writing right now, can be torn, so those copies are dropped.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint32 EndAfter = NumWritten.load(std::memory_order_relaxed);
+    const uint32 FirstIntact = EndAfter + 1 > Capacity ? EndAfter + 1 - Capacity : 0;
+
+    if (FirstIntact > Begin)
+    {
+        OutRecords.RemoveAt(FirstOut, FMath::Min(FirstIntact, End) - Begin, EAllowShrinking::No);
+    }
+
+    return OutRecords.Num() - FirstOut;
+}
+
+bool FAIBuilderStateHistoryDump::Serialize(FArchive& Ar)
+{
+    uint32 Magic = AIBuilderStateHistory::Magic;
+    uint32 Version = AIBuilderStateHistory::Version;
+    Ar << Magic << Version;
+
+    if (Ar.IsLoading() && (Magic != AIBuilderStateHistory::Magic || Version > AIBuilderStateHistory::Version))
+    {
+        return false;
+    }
+
+    Ar << CaptureTime;
+
+    int32 NumAgents = Agents.Num();
+    Ar << NumAgents;
+
+    if (Ar.IsLoading())
+    {
+        if (NumAgents < 0)
+        {
+            return false;
+        }
+
+        Agents.SetNum(NumAgents);
+    }
+
+    for (FAgent& Agent : Agents)
+    {
+        Ar << Agent.Name << Agent.NumTransitions << Agent.Records;
+    }
+
+    Ar << TargetNames;
+
+    return !Ar.IsError();
+}
+
+bool FAIBuilderStateHistoryDump::SaveToFile(const FString& Filename)
+{
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+
+    return Serialize(Writer) && FFileHelper::SaveArrayToFile(Bytes, *Filename);
+}
+
+bool FAIBuilderStateHistoryDump::LoadFromFile(const FString& Filename)
+{
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *Filename))
+    {
+        return false;
+    }
+
+    FMemoryReader Reader(Bytes);
+    return Serialize(Reader);
+}
+
+FAIBuilderStateHistoryDump FAIBuilderStateHistoryDump::Capture(UWorld* World)
+{
+    FAIBuilderStateHistoryDump Dump;
+    if (!World)
+    {
+        return Dump;
+    }
+
+    Dump.CaptureTime = World->GetTimeSeconds();
+
+    for (TObjectIterator<UAIBuilderStateMachine> It; It; ++It)
+    {
+        const FAIBuilderStateHistory* History = It->GetHistory();
+        if (It->GetWorld() != World || !History)
+        {
+            continue;
+        }
+
+        FAgent& Agent = Dump.Agents.AddDefaulted_GetRef();
+        Agent.Name = GetNameSafe(It->GetOwner());
+        Agent.NumTransitions = History->GetNumWritten();
+        History->Snapshot(Agent.Records);
+
+        // Best effort, a target destroyed since may have handed its ID to another object
+        for (const FAIBuilderTransitionRecord& Record : Agent.Records)
+        {
+            if (Record.TargetId == 0 || Dump.TargetNames.Contains(Record.TargetId))
+            {
+                continue;
+            }
+
+            const FUObjectItem* Item = GUObjectArray.IndexToObject(static_cast<int32>(Record.TargetId));
+            const UObject* Target = Item ? static_cast<const UObject*>(Item->Object) : nullptr;
+            Dump.TargetNames.Add(Record.TargetId, Target ? Target->GetName() : FString::Printf(TEXT("Target_%u"), Record.TargetId));
+        }
+    }
+
+    return Dump;
+}
+
+FString FAIBuilderStateHistoryDump::MakeDefaultFilename()
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AIBuilder"),
+                           FString::Printf(TEXT("StateHistory-%s.aibh"), *FDateTime::Now().ToString()));
+}
+
+static FAutoConsoleCommandWithWorldAndArgs DumpStateHistoryCommand(
+    TEXT("AIBuilder.DumpStateHistory"),
+    TEXT("Writes the state transition history of every agent to a binary file. Optional argument: file name."),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        FAIBuilderStateHistoryDump Dump = FAIBuilderStateHistoryDump::Capture(World);
+        const FString Filename = Args.Num() > 0 ? Args[0] : FAIBuilderStateHistoryDump::MakeDefaultFilename();
+
+        if (Dump.SaveToFile(Filename))
+        {
+            UE_LOG(LogAIBuilder, Log, TEXT("State history of %d agents written to %s"), Dump.Agents.Num(), *Filename);
+        }
+        else
+        {
+            UE_LOG(LogAIBuilder, Error, TEXT("Failed to write state history to %s"), *Filename);
+        }
+    }));
@@ -1,11 +1,28 @@
 // AIBuilderStateMachine.cpp - State Machine Implementation
 #include "Components/AIBuilderStateMachine.h"
+#include "Components/AIBuilderStateTable.h"
+#include "Components/AIBuilderSubStates.h"
 #include "Core/AIBuilderCharacter.h"
+#include "Subsystems/AIBuilderStateBatchSubsystem.h"
+#include "Subsystems/AIBuilderTimingWheelSubsystem.h"
 #include "GameFramework/Character.h"
 #include "AIController.h"
 #include "AIBuilder.h"
+#include "AIBuilderStats.h"
 #include "Engine/Engine.h"
 
+namespace AIBuilderStateMachine
+{
+    FAIBuilderCompiledStateTable::FConditionInputs MakeConditionInputs(const FAIBuilderTargetContext& Context, float TimeInState)
+    {
+        FAIBuilderCompiledStateTable::FConditionInputs Inputs;
+        Inputs.bHasTarget = Context.bHasTarget;
+        Inputs.bInAttackRange = Context.bInAttackRange;
+        Inputs.TimeInState = TimeInState;
+        return Inputs;
+    }
+}
+
 UAIBuilderStateMachine::UAIBuilderStateMachine()
 {
     PrimaryComponentTick.bCanEverTick = false;
@@ -13,14 +30,57 @@ UAIBuilderStateMachine::UAIBuilderStateMachine()
     PreviousState = EAIBuilderState::Idle;
     StateTimer = 0.0f;
     LastTransitionTime = 0.0f;
+    StateEnterTime = 0.0f;
+    StateTable = nullptr;
+    BatchSubsystem = nullptr;
+    BatchIndex = INDEX_NONE;
+    TimingWheel = nullptr;
+    WheelToken = 0;
+    SubStateEnterTime = 0.0f;
+    SubStateSerial = 0;
+    bSwitchingSubStates = false;
 }
 
 void UAIBuilderStateMachine::BeginPlay()
 {
     Super::BeginPlay();
+
+    if (bRecordHistory && !History)
+    {
+        History = MakeUnique<FAIBuilderStateHistory>();
+    }
+
     EnterState(CurrentState);
 }
 
+void UAIBuilderStateMachine::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (BatchSubsystem)
+    {
+        BatchSubsystem->UnregisterStateMachine(this);
+    }
+
+    if (TimingWheel)
+    {
+        if (OwnerCharacter)
+        {
+            OwnerCharacter->OnTargetChanged.RemoveAll(this);
+
+            if (UAIBuilderSensorComponent* Sensor = OwnerCharacter->GetSensorComponent())
+            {
+                Sensor->OnActorDetected.RemoveAll(this);
+                Sensor->OnActorLost.RemoveAll(this);
+            }
+        }
+
+        // Drops the timer that is still on the wheel
+        WheelToken++;
+        TimingWheel = nullptr;
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void UAIBuilderStateMachine::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
@@ -29,44 +89,74 @@ void UAIBuilderStateMachine::TickComponent(float DeltaTime, ELevelTick TickType,
 void UAIBuilderStateMachine::Initialize(AAIBuilderCharacter* InOwnerCharacter)
 {
     OwnerCharacter = InOwnerCharacter;
+
+    if (UpdateMode == EAIBuilderStateUpdateMode::Batched && !BatchSubsystem)
+    {
+        if (UAIBuilderStateBatchSubsystem* Subsystem = GetWorld()->GetSubsystem<UAIBuilderStateBatchSubsystem>())
+        {
+            Subsystem->RegisterStateMachine(this);
+        }
+    }
+    else if (UpdateMode == EAIBuilderStateUpdateMode::EventDriven && !TimingWheel && OwnerCharacter)
+    {
+        TimingWheel = GetWorld()->GetSubsystem<UAIBuilderTimingWheelSubsystem>();
+        if (TimingWheel)
+        {
+            OwnerCharacter->OnTargetChanged.AddUObject(this, &UAIBuilderStateMachine::HandleTargetChanged);
+
+            if (UAIBuilderSensorComponent* Sensor = OwnerCharacter->GetSensorComponent())
+            {
+                Sensor->OnActorDetected.AddDynamic(this, &UAIBuilderStateMachine::HandleActorDetected);
+                Sensor->OnActorLost.AddDynamic(this, &UAIBuilderStateMachine::HandleActorLost);
+            }
+
+            // Nothing polls us from here on, so pick up the current situation once
+            ReevaluateTransitions();
+        }
+    }
+
     UE_LOG(LogAIBuilder, Log, TEXT("State Machine initialized for %s"), 
            OwnerCharacter ? *OwnerCharacter->GetName() : TEXT("Unknown"));
 }
 
 void UAIBuilderStateMachine::UpdateState(float DeltaTime)
 {
-    if (!OwnerCharacter)
+    // Batched state machines are updated elsewhere
+    if (!OwnerCharacter || IsBatched())
     {
         return;
     }
 
+    // Event driven transitions happen elsewhere, only the sub-states still want a tick
+    if (IsEventDriven())
+    {
+        UpdateSubStates(DeltaTime);
+        return;
+    }
+
+    AIBUILDER_SCOPE_CYCLE_COUNTER(STAT_AIBuilder_StateUpdate);
+
     StateTimer += DeltaTime;
 
-    // Update current state logic
-    switch (CurrentState)
+    UpdateTargetContext();
+    const FAIBuilderCompiledStateTable::FConditionInputs Inputs = AIBuilderStateMachine::MakeConditionInputs(TargetContext, StateTimer);
+
+    EAIBuilderState NewState;
+    uint32 ConditionMask;
+    if (GetTransitionTable().FindTransition(CurrentState, Inputs, NewState, &ConditionMask))
     {
-        case EAIBuilderState::Idle:
-            UpdateIdleState(DeltaTime);
-            break;
-        case EAIBuilderState::Patrol:
-            UpdatePatrolState(DeltaTime);
-            break;
-        case EAIBuilderState::Chase:
-            UpdateChaseState(DeltaTime);
-            break;
-        case EAIBuilderState::Attack:
-            UpdateAttackState(DeltaTime);
-            break;
-        case EAIBuilderState::Search:
-            UpdateSearchState(DeltaTime);
-            break;
-        case EAIBuilderState::Return:
-            UpdateReturnState(DeltaTime);
-            break;
+        TryChangeState(NewState, EAIBuilderTransitionReason::Rule, ConditionMask);
     }
+
+    UpdateSubStates(DeltaTime);
 }
 
 void UAIBuilderStateMachine::ChangeState(EAIBuilderState NewState)
+{
+    TryChangeState(NewState, EAIBuilderTransitionReason::Manual, 0);
+}
+
+void UAIBuilderStateMachine::TryChangeState(EAIBuilderState NewState, EAIBuilderTransitionReason Reason, uint32 ConditionMask)
 {
     if (CurrentState == NewState || !CanTransitionTo(NewState))
     {
@@ -81,6 +171,7 @@ void UAIBuilderStateMachine::ChangeState(EAIBuilderState NewState)
     }
 
     EAIBuilderState OldState = CurrentState;
+    const FName OldSubState = GetCurrentSubState();
     ExitState(CurrentState);
     
     PreviousState = CurrentState;
@@ -88,49 +179,52 @@ void UAIBuilderStateMachine::ChangeState(EAIBuilderState NewState)
     
     EnterState(NewState);
     LastTransitionTime = CurrentTime;
+    INC_DWORD_STAT(STAT_AIBuilder_StateTransitions);
+
+    if (History)
+    {
+        const AActor* Target = OwnerCharacter ? OwnerCharacter->GetCurrentTarget() : nullptr;
+
+        FAIBuilderTransitionRecord Record;
+        Record.Time = CurrentTime;
+        Record.TargetDistance = Target ? FVector::Dist(OwnerCharacter->GetActorLocation(), Target->GetActorLocation()) : -1.0f;
+        Record.TargetId = Target ? Target->GetUniqueID() : 0;
+        Record.OldState = static_cast<uint8>(OldState);
+        Record.NewState = static_cast<uint8>(NewState);
+        Record.Reason = static_cast<uint8>(Reason);
+        Record.ConditionMask = static_cast<uint8>(ConditionMask);
+        History->Record(Record);
+    }
+
+    if (BatchSubsystem)
+    {
+        BatchSubsystem->NotifyStateChanged(BatchIndex, NewState, CurrentTime);
+    }
+    
+    // Event driven machines need the new state's timers, also when Blueprint changed the state.
+    // Rules that already hold on entry are held back by the delay, so look again once it ends.
+    if (TimingWheel)
+    {
+        ScheduleNextEvaluation(true);
+    }
     
     OnStateChanged.Broadcast(OldState, NewState);
+
+    const FName NewSubState = GetCurrentSubState();
+    if (NewSubState != OldSubState)
+    {
+        OnSubStateChanged.Broadcast(OldSubState, NewSubState);
+    }
     
-    UE_LOG(LogAIBuilder, Log, TEXT("%s: State changed from %s to %s"), 
-           *OwnerCharacter->GetName(), 
+    UE_LOG(LogAIBuilder, Verbose, TEXT("%s: State changed from %s to %s"), 
+           *GetNameSafe(OwnerCharacter), 
            *UEnum::GetValueAsString(OldState), 
            *UEnum::GetValueAsString(NewState));
 }
 
 bool UAIBuilderStateMachine::CanTransitionTo(EAIBuilderState NewState) const
 {
-    // Define state transition rules here
-    switch (CurrentState)
-    {
-        case EAIBuilderState::Idle:
-            return NewState == EAIBuilderState::Patrol || 
-                   NewState == EAIBuilderState::Chase;
-        
-        case EAIBuilderState::Patrol:
-            return NewState == EAIBuilderState::Idle || 
-                   NewState == EAIBuilderState::Chase ||
-                   NewState == EAIBuilderState::Search;
-        
-        case EAIBuilderState::Chase:
-            return NewState == EAIBuilderState::Attack || 
-                   NewState == EAIBuilderState::Search ||
-                   NewState == EAIBuilderState::Patrol;
-        
-        case EAIBuilderState::Attack:
-            return NewState == EAIBuilderState::Chase || 
-                   NewState == EAIBuilderState::Search;
-        
-        case EAIBuilderState::Search:
-            return NewState == EAIBuilderState::Patrol || 
-                   NewState == EAIBuilderState::Chase ||
-                   NewState == EAIBuilderState::Return;
-        
-        case EAIBuilderState::Return:
-            return NewState == EAIBuilderState::Patrol || 
-                   NewState == EAIBuilderState::Idle;
-    }
-    
-    return false;
+    return NewState < EAIBuilderState::MAX && GetTransitionTable().IsAllowed(CurrentState, NewState);
 }
 
 FString UAIBuilderStateMachine::GetCurrentStateName() const
@@ -138,99 +232,238 @@ FString UAIBuilderStateMachine::GetCurrentStateName() const
     return UEnum::GetValueAsString(CurrentState);
 }
 
-void UAIBuilderStateMachine::UpdateIdleState(float DeltaTime)
+bool UAIBuilderStateMachine::ChangeSubState(FName SubState)
 {
-    // Check if we should start patrolling
-    if (StateTimer > 2.0f)
+    if (bSwitchingSubStates)
     {
-        ChangeState(EAIBuilderState::Patrol);
+        UE_LOG(LogAIBuilder, Warning, TEXT("ChangeSubState(%s) ignored, sub-states are already switching"), *SubState.ToString());
+        return false;
     }
-    
-    // Check for targets
-    if (HasValidTarget())
+
+    FAIBuilderSubStateRegistry& Registry = FAIBuilderSubStateRegistry::Get();
+
+    int32 LeafIndex = INDEX_NONE;
+    if (!SubState.IsNone())
+    {
+        const int32 Index = Registry.Find(SubStateArchetype, SubState);
+        if (Index == INDEX_NONE || Registry.GetDesc(Index).RootState != CurrentState)
+        {
+            UE_LOG(LogAIBuilder, Warning, TEXT("%s is not a sub-state of %s"), *SubState.ToString(), *GetCurrentStateName());
+            return false;
+        }
+
+        LeafIndex = Registry.GetDefaultLeaf(SubStateArchetype, Index);
+    }
+
+    const FName OldSubState = GetCurrentSubState();
+    SwitchSubStates(LeafIndex);
+
+    const FName NewSubState = GetCurrentSubState();
+    if (NewSubState != OldSubState)
     {
-        ChangeState(EAIBuilderState::Chase);
+        OnSubStateChanged.Broadcast(OldSubState, NewSubState);
     }
+
+    return true;
 }
 
-void UAIBuilderStateMachine::UpdatePatrolState(float DeltaTime)
+FName UAIBuilderStateMachine::GetCurrentSubState() const
 {
-    // Check for targets
-    if (HasValidTarget())
+    return SubStateStack.Num() > 0 ? FAIBuilderSubStateRegistry::Get().GetDesc(SubStateStack.Last()).Path : NAME_None;
+}
+
+bool UAIBuilderStateMachine::IsInSubState(FName SubState) const
+{
+    const FAIBuilderSubStateRegistry& Registry = FAIBuilderSubStateRegistry::Get();
+    for (const int32 Index : SubStateStack)
     {
-        ChangeState(EAIBuilderState::Chase);
-        return;
+        if (Registry.GetDesc(Index).Path == SubState)
+        {
+            return true;
+        }
     }
-    
-    // Continue patrolling logic would be handled by behavior tree
-    // This is just state management
+
+    return false;
 }
 
-void UAIBuilderStateMachine::UpdateChaseState(float DeltaTime)
+void UAIBuilderStateMachine::SwitchSubStates(int32 LeafIndex)
 {
-    if (!HasValidTarget())
+    // Enter and Exit hooks must not change the state or sub-state, the stack is mid-rebuild
+    if (!ensureMsgf(!bSwitchingSubStates, TEXT("Sub-states switched from inside an Enter or Exit hook")))
     {
-        ChangeState(EAIBuilderState::Search);
         return;
     }
-    
-    if (IsInAttackRange())
+
+    FAIBuilderSubStateRegistry& Registry = FAIBuilderSubStateRegistry::Get();
+
+    TArray<int32, TInlineAllocator<4>> NewStack;
+    Registry.GetChain(SubStateArchetype, LeafIndex, NewStack);
+
+    // Sub-states shared by the old and new chain stay active
+    int32 CommonDepth = 0;
+    while (CommonDepth < SubStateStack.Num() && CommonDepth < NewStack.Num() && SubStateStack[CommonDepth] == NewStack[CommonDepth])
+    {
+        CommonDepth++;
+    }
+
+    if (CommonDepth == SubStateStack.Num() && CommonDepth == NewStack.Num())
     {
-        ChangeState(EAIBuilderState::Attack);
+        return;
+    }
+
+    TGuardValue<bool> SwitchingGuard(bSwitchingSubStates, true);
+
+    const float CurrentTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
+    FAIBuilderSubStateContext Context{ this, OwnerCharacter, TargetContext, CurrentTime - SubStateEnterTime };
+
+    // Innermost first on the way out, outermost first on the way in
+    while (SubStateStack.Num() > CommonDepth)
+    {
+        Registry.GetDesc(SubStateStack.Pop(EAllowShrinking::No)).Exit(Context);
+    }
+
+    Context.TimeInSubState = 0.0f;
+    SubStateEnterTime = CurrentTime;
+    SubStateSerial++;
+
+    for (int32 Depth = CommonDepth; Depth < NewStack.Num(); Depth++)
+    {
+        SubStateStack.Add(NewStack[Depth]);
+        Registry.GetDesc(NewStack[Depth]).Enter(Context);
     }
 }
 
-void UAIBuilderStateMachine::UpdateAttackState(float DeltaTime)
+void UAIBuilderStateMachine::UpdateSubStates(float DeltaTime)
 {
-    if (!HasValidTarget())
+    if (SubStateStack.Num() == 0)
     {
-        ChangeState(EAIBuilderState::Search);
         return;
     }
-    
-    if (!IsInAttackRange())
+
+    const FAIBuilderSubStateRegistry& Registry = FAIBuilderSubStateRegistry::Get();
+    FAIBuilderSubStateContext Context{ this, OwnerCharacter, TargetContext, GetWorld()->GetTimeSeconds() - SubStateEnterTime };
+
+    const uint32 Serial = SubStateSerial;
+    for (int32 Depth = 0; Depth < SubStateStack.Num(); Depth++)
     {
-        ChangeState(EAIBuilderState::Chase);
+        Registry.GetDesc(SubStateStack[Depth]).Update(Context, DeltaTime);
+
+        // The hook switched sub-states or the state itself, the rest of the old chain is gone
+        if (SubStateSerial != Serial)
+        {
+            break;
+        }
+    }
+}
+
+void UAIBuilderStateMachine::OnTimingWheelFired(uint32 Token)
+{
+    if (Token == WheelToken && TimingWheel)
+    {
+        ReevaluateTransitions();
     }
-    
-    // Attack logic would be handled elsewhere
-    // This manages state transitions only
 }
 
-void UAIBuilderStateMachine::UpdateSearchState(float DeltaTime)
+void UAIBuilderStateMachine::ReevaluateTransitions()
 {
-    if (HasValidTarget())
+    if (!OwnerCharacter)
     {
-        ChangeState(EAIBuilderState::Chase);
         return;
     }
-    
-    // Search for a limited time then return to patrol
-    if (StateTimer > 5.0f)
+
+    AIBUILDER_SCOPE_CYCLE_COUNTER(STAT_AIBuilder_StateUpdate);
+
+    // Nothing advances the timer between events, derive it from the entry time
+    StateTimer = GetWorld()->GetTimeSeconds() - StateEnterTime;
+
+    UpdateTargetContext();
+    const FAIBuilderCompiledStateTable::FConditionInputs Inputs = AIBuilderStateMachine::MakeConditionInputs(TargetContext, StateTimer);
+
+    EAIBuilderState NewState;
+    uint32 ConditionMask;
+    if (!GetTransitionTable().FindTransition(CurrentState, Inputs, NewState, &ConditionMask))
     {
-        ChangeState(EAIBuilderState::Return);
+        ScheduleNextEvaluation(false);
+        return;
+    }
+
+    // Rule targets are always allowed, so the only way this fails is the transition delay.
+    // On success ChangeState has already scheduled the new state.
+    const EAIBuilderState OldState = CurrentState;
+    TryChangeState(NewState, EAIBuilderTransitionReason::Rule, ConditionMask);
+
+    if (CurrentState == OldState)
+    {
+        ScheduleNextEvaluation(true);
     }
 }
 
-void UAIBuilderStateMachine::UpdateReturnState(float DeltaTime)
+void UAIBuilderStateMachine::ScheduleNextEvaluation(bool bRetryAfterTransitionDelay)
 {
-    if (HasValidTarget())
+    if (!TimingWheel)
     {
-        ChangeState(EAIBuilderState::Chase);
         return;
     }
-    
-    // Logic to return to patrol point would be in behavior tree
-    // Transition back to patrol when close to original position
-    if (StateTimer > 3.0f)
+
+    const float CurrentTime = GetWorld()->GetTimeSeconds();
+    const float TimeInState = CurrentTime - StateEnterTime;
+    const FAIBuilderCompiledStateTable& Table = GetTransitionTable();
+
+    float Delay = TNumericLimits<float>::Max();
+
+    // Timed rules wake us exactly when they can first pass
+    const float NextThreshold = Table.FindNextTimeThreshold(CurrentState, TimeInState);
+    if (NextThreshold < TNumericLimits<float>::Max())
     {
-        ChangeState(EAIBuilderState::Patrol);
+        Delay = NextThreshold - TimeInState;
     }
+
+    if (HasValidTarget() && (Table.UsesCondition(CurrentState, EAIBuilderConditionType::InAttackRange) ||
+                             Table.UsesCondition(CurrentState, EAIBuilderConditionType::OutOfAttackRange)))
+    {
+        Delay = FMath::Min(Delay, RangeCheckInterval);
+    }
+
+    // A rule may already hold, retry as soon as the transition delay allows it
+    if (bRetryAfterTransitionDelay)
+    {
+        Delay = FMath::Min(Delay, LastTransitionTime + StateTransitionDelay - CurrentTime);
+    }
+
+    // Supersedes any timer still on the wheel. With nothing to wait for, no timer is needed at all.
+    WheelToken++;
+    if (Delay < TNumericLimits<float>::Max())
+    {
+        TimingWheel->Schedule(this, WheelToken, Delay);
+    }
+}
+
+void UAIBuilderStateMachine::HandleTargetChanged(AActor* OldTarget, AActor* NewTarget)
+{
+    ReevaluateTransitions();
+}
+
+void UAIBuilderStateMachine::HandleActorDetected(AActor* DetectedActor, ESensorType SensorType, float Confidence)
+{
+    ReevaluateTransitions();
+}
+
+void UAIBuilderStateMachine::HandleActorLost(AActor* LostActor, ESensorType SensorType)
+{
+    ReevaluateTransitions();
+}
+
+const FAIBuilderCompiledStateTable& UAIBuilderStateMachine::GetTransitionTable() const
+{
+    return StateTable ? StateTable->GetCompiledTable() : UAIBuilderStateTable::GetDefaultCompiledTable();
 }
 
 void UAIBuilderStateMachine::EnterState(EAIBuilderState NewState)
 {
     StateTimer = 0.0f;
+    StateEnterTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
+
+    SwitchSubStates(FAIBuilderSubStateRegistry::Get().GetDefaultLeaf(SubStateArchetype, NewState));
     
     // State-specific entry logic
     switch (NewState)
@@ -261,11 +494,15 @@ void UAIBuilderStateMachine::EnterState(EAIBuilderState NewState)
                 OwnerCharacter->SetMovementSpeed(OwnerCharacter->MovementSpeed / 1.5f);
             }
             break;
+        default:
+            break;
     }
 }
 
 void UAIBuilderStateMachine::ExitState(EAIBuilderState OldState)
 {
+    SwitchSubStates(INDEX_NONE);
+
     // State-specific exit logic
     switch (OldState)
     {
@@ -277,28 +514,44 @@ void UAIBuilderStateMachine::ExitState(EAIBuilderState OldState)
     }
 }
 
-bool UAIBuilderStateMachine::HasValidTarget() const
+void UAIBuilderStateMachine::UpdateTargetContext()
 {
-    return OwnerCharacter && OwnerCharacter->GetCurrentTarget() != nullptr;
+    AActor* Target = OwnerCharacter ? OwnerCharacter->GetCurrentTarget() : nullptr;
+    if (!Target)
+    {
+        SetTargetContext(nullptr, FVector::ZeroVector, 0.0f, false);
+        return;
+    }
+
+    const FVector Delta = Target->GetActorLocation() - OwnerCharacter->GetActorLocation();
+    const float DistanceSquared = Delta.SizeSquared();
+    SetTargetContext(Target, Delta, DistanceSquared, DistanceSquared <= FMath::Square(OwnerCharacter->AttackRange));
 }
 
-float UAIBuilderStateMachine::GetDistanceToTarget() const
+void UAIBuilderStateMachine::SetTargetContext(AActor* Target, const FVector& Delta, float DistanceSquared, bool bInAttackRange)
 {
-    if (!HasValidTarget())
+    TargetContext = FAIBuilderTargetContext();
+
+    if (!Target)
     {
-        return -1.0f;
+        return;
     }
-    
-    return FVector::Dist(OwnerCharacter->GetActorLocation(), 
-                        OwnerCharacter->GetCurrentTarget()->GetActorLocation());
-}
 
-bool UAIBuilderStateMachine::IsInAttackRange() const
-{
-    if (!HasValidTarget())
+    TargetContext.Target = Target;
+    TargetContext.bHasTarget = true;
+    TargetContext.DistanceSquared = DistanceSquared;
+    TargetContext.bInAttackRange = bInAttackRange;
+
+    // One reciprocal square root gives both distance and direction
+    if (TargetContext.DistanceSquared > UE_SMALL_NUMBER)
     {
-        return false;
+        const float InvDistance = FMath::InvSqrt(TargetContext.DistanceSquared);
+        TargetContext.Distance = TargetContext.DistanceSquared * InvDistance;
+        TargetContext.Direction = Delta * InvDistance;
     }
-    
-    return GetDistanceToTarget() <= OwnerCharacter->AttackRange;
-}s
\ No newline at end of file
+}
+
+bool UAIBuilderStateMachine::HasValidTarget() const
+{
+    return OwnerCharacter && OwnerCharacter->GetCurrentTarget() != nullptr;
+}
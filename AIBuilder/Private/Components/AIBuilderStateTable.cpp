@@ -0,0 +1,192 @@
+// AIBuilderStateTable.cpp - State transition table implementation
+#include "Components/AIBuilderStateTable.h"
+#include "AIBuilder.h"
+
+void FAIBuilderCompiledStateTable::Compile(TConstArrayView<FAIBuilderTransitionRule> InRules)
+{
+    Rules.Reset();
+    Conditions.Reset();
+
+    // Group the automatic rules by source state, keeping authored order within each state
+    for (int32 StateIndex = 0; StateIndex < NumStates; StateIndex++)
+    {
+        FStateEntry& Entry = States[StateIndex];
+        Entry.AllowedMask = 0;
+        Entry.ConditionMask = 0;
+        Entry.FirstRule = Rules.Num();
+
+        for (const FAIBuilderTransitionRule& Rule : InRules)
+        {
+            const int32 ToIndex = static_cast<int32>(Rule.To);
+            if (static_cast<int32>(Rule.From) != StateIndex || ToIndex >= NumStates || ToIndex == StateIndex)
+            {
+                continue;
+            }
+
+            Entry.AllowedMask |= 1u << ToIndex;
+
+            if (Rule.bManual)
+            {
+                continue;
+            }
+
+            FRule& CompiledRule = Rules.AddDefaulted_GetRef();
+            CompiledRule.To = Rule.To;
+            CompiledRule.FirstCondition = Conditions.Num();
+            CompiledRule.NumConditions = Rule.Conditions.Num();
+
+            for (const FAIBuilderTransitionCondition& Condition : Rule.Conditions)
+            {
+                Conditions.Add({ Condition.Type, Condition.Value });
+                Entry.ConditionMask |= 1u << static_cast<uint32>(Condition.Type);
+            }
+        }
+
+        Entry.NumRules = Rules.Num() - Entry.FirstRule;
+    }
+}
+
+bool FAIBuilderCompiledStateTable::FindTransition(EAIBuilderState From, const FConditionInputs& Inputs, EAIBuilderState& OutTo, uint32* OutConditionMask) const
+{
+    for (const FRule& Rule : GetRules(From))
+    {
+        bool bConditionsMet = true;
+        for (const FCondition& Condition : GetConditions(Rule))
+        {
+            switch (Condition.Type)
+            {
+                case EAIBuilderConditionType::HasTarget:
+                    bConditionsMet = Inputs.bHasTarget;
+                    break;
+                case EAIBuilderConditionType::NoTarget:
+                    bConditionsMet = !Inputs.bHasTarget;
+                    break;
+                case EAIBuilderConditionType::InAttackRange:
+                    bConditionsMet = Inputs.bInAttackRange;
+                    break;
+                case EAIBuilderConditionType::OutOfAttackRange:
+                    bConditionsMet = Inputs.bHasTarget && !Inputs.bInAttackRange;
+                    break;
+                case EAIBuilderConditionType::TimeInState:
+                    bConditionsMet = Inputs.TimeInState > Condition.Value;
+                    break;
+            }
+
+            if (!bConditionsMet)
+            {
+                break;
+            }
+        }
+
+        if (bConditionsMet)
+        {
+            OutTo = Rule.To;
+
+            if (OutConditionMask)
+            {
+                *OutConditionMask = 0;
+                for (const FCondition& Condition : GetConditions(Rule))
+                {
+                    *OutConditionMask |= 1u << static_cast<uint32>(Condition.Type);
+                }
+            }
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+float FAIBuilderCompiledStateTable::FindNextTimeThreshold(EAIBuilderState From, float TimeInState) const
+{
+    float NextThreshold = TNumericLimits<float>::Max();
+
+    for (const FRule& Rule : GetRules(From))
+    {
+        for (const FCondition& Condition : GetConditions(Rule))
+        {
+            if (Condition.Type == EAIBuilderConditionType::TimeInState && Condition.Value >= TimeInState)
+            {
+                NextThreshold = FMath::Min(NextThreshold, Condition.Value);
+            }
+        }
+    }
+
+    return NextThreshold;
+}
+
+UAIBuilderStateTable::UAIBuilderStateTable()
+{
+    // New assets start from the built-in behavior
+    GetDefaultTransitions(Transitions);
+}
+
+void UAIBuilderStateTable::PostInitProperties()
+{
+    Super::PostInitProperties();
+    Compile();
+}
+
+void UAIBuilderStateTable::PostLoad()
+{
+    Super::PostLoad();
+    Compile();
+}
+
+#if WITH_EDITOR
+void UAIBuilderStateTable::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    Compile();
+}
+#endif
+
+void UAIBuilderStateTable::Compile()
+{
+    CompiledTable.Compile(Transitions);
+    UE_LOG(LogAIBuilder, Verbose, TEXT("Compiled state table %s with %d transitions"), *GetName(), Transitions.Num());
+}
+
+void UAIBuilderStateTable::GetDefaultTransitions(TArray<FAIBuilderTransitionRule>& OutTransitions)
+{
+    using ECondition = EAIBuilderConditionType;
+
+    OutTransitions.Reset();
+
+    OutTransitions.Emplace(EAIBuilderState::Idle, EAIBuilderState::Chase, TArray<FAIBuilderTransitionCondition>{ ECondition::HasTarget });
+    OutTransitions.Emplace(EAIBuilderState::Idle, EAIBuilderState::Patrol, TArray<FAIBuilderTransitionCondition>{ { ECondition::TimeInState, 2.0f } });
+
+    OutTransitions.Emplace(EAIBuilderState::Patrol, EAIBuilderState::Chase, TArray<FAIBuilderTransitionCondition>{ ECondition::HasTarget });
+    OutTransitions.Emplace(EAIBuilderState::Patrol, EAIBuilderState::Idle, TArray<FAIBuilderTransitionCondition>(), true);
+    OutTransitions.Emplace(EAIBuilderState::Patrol, EAIBuilderState::Search, TArray<FAIBuilderTransitionCondition>(), true);
+
+    OutTransitions.Emplace(EAIBuilderState::Chase, EAIBuilderState::Search, TArray<FAIBuilderTransitionCondition>{ ECondition::NoTarget });
+    OutTransitions.Emplace(EAIBuilderState::Chase, EAIBuilderState::Attack, TArray<FAIBuilderTransitionCondition>{ ECondition::InAttackRange });
+    OutTransitions.Emplace(EAIBuilderState::Chase, EAIBuilderState::Patrol, TArray<FAIBuilderTransitionCondition>(), true);
+
+    OutTransitions.Emplace(EAIBuilderState::Attack, EAIBuilderState::Search, TArray<FAIBuilderTransitionCondition>{ ECondition::NoTarget });
+    OutTransitions.Emplace(EAIBuilderState::Attack, EAIBuilderState::Chase, TArray<FAIBuilderTransitionCondition>{ ECondition::OutOfAttackRange });
+
+    OutTransitions.Emplace(EAIBuilderState::Search, EAIBuilderState::Chase, TArray<FAIBuilderTransitionCondition>{ ECondition::HasTarget });
+    OutTransitions.Emplace(EAIBuilderState::Search, EAIBuilderState::Return, TArray<FAIBuilderTransitionCondition>{ { ECondition::TimeInState, 5.0f } });
+    OutTransitions.Emplace(EAIBuilderState::Search, EAIBuilderState::Patrol, TArray<FAIBuilderTransitionCondition>(), true);
+
+    OutTransitions.Emplace(EAIBuilderState::Return, EAIBuilderState::Patrol, TArray<FAIBuilderTransitionCondition>{ { ECondition::TimeInState, 3.0f } });
+    OutTransitions.Emplace(EAIBuilderState::Return, EAIBuilderState::Idle, TArray<FAIBuilderTransitionCondition>(), true);
+}
+
+const FAIBuilderCompiledStateTable& UAIBuilderStateTable::GetDefaultCompiledTable()
+{
+    static const FAIBuilderCompiledStateTable DefaultTable = []()
+    {
+        TArray<FAIBuilderTransitionRule> DefaultTransitions;
+        GetDefaultTransitions(DefaultTransitions);
+
+        FAIBuilderCompiledStateTable Table;
+        Table.Compile(DefaultTransitions);
+        return Table;
+    }();
+
+    return DefaultTable;
+}
@@ -0,0 +1,217 @@
+// AIBuilderSubStates.cpp - Sub-state registry implementation
+#include "Components/AIBuilderSubStates.h"
+#include "AIBuilder.h"
+#include "Algo/Reverse.h"
+
+FAIBuilderSubStateRegistry& FAIBuilderSubStateRegistry::Get()
+{
+    // Function local so registrars in other translation units never see it unconstructed
+    static FAIBuilderSubStateRegistry Registry;
+    return Registry;
+}
+
+FAIBuilderSubStateRegistry::FAIBuilderSubStateRegistry()
+{
+    bFinalized = false;
+}
+
+void FAIBuilderSubStateRegistry::Register(const TCHAR* Archetype, EAIBuilderState RootState, const TCHAR* Path, bool bIsDefault,
+                                          FAIBuilderSubStateDesc::FEnterFunc Enter, FAIBuilderSubStateDesc::FUpdateFunc Update, FAIBuilderSubStateDesc::FExitFunc Exit)
+{
+    check(RootState < EAIBuilderState::MAX);
+
+    // FNames are only built in Finalize, this can run before the name table exists
+    FAIBuilderSubStateDesc& Desc = States.AddDefaulted_GetRef();
+    Desc.PathString = Path;
+    Desc.RootState = RootState;
+    Desc.bIsDefault = bIsDefault;
+    Desc.ArchetypeString = Archetype;
+    Desc.Enter = Enter;
+    Desc.Update = Update;
+    Desc.Exit = Exit;
+
+    bFinalized = false;
+}
+
+void FAIBuilderSubStateRegistry::Finalize()
+{
+    if (bFinalized)
+    {
+        return;
+    }
+
+    bFinalized = true;
+    ArchetypeViews.Reset();
+    ArchetypeToView.Reset();
+
+    ArchetypeViews.AddDefaulted();
+    ArchetypeToView.Add(NAME_None, 0);
+
+    for (FAIBuilderSubStateDesc& Desc : States)
+    {
+        Desc.Path = FName(Desc.PathString);
+        Desc.Archetype = Desc.ArchetypeString ? FName(Desc.ArchetypeString) : NAME_None;
+
+        if (!ArchetypeToView.Contains(Desc.Archetype))
+        {
+            ArchetypeToView.Add(Desc.Archetype, ArchetypeViews.Num());
+            ArchetypeViews.AddDefaulted_GetRef().Name = Desc.Archetype;
+        }
+    }
+
+    for (FArchetypeView& View : ArchetypeViews)
+    {
+        BuildArchetypeView(View);
+    }
+
+    UE_LOG(LogAIBuilder, Verbose, TEXT("Sub-state registry finalized with %d sub-states for %d archetypes"), States.Num(), ArchetypeViews.Num() - 1);
+}
+
+void FAIBuilderSubStateRegistry::BuildArchetypeView(FArchetypeView& View)
+{
+    View.PathToIndex.Reset();
+    View.ParentIndices.Init(INDEX_NONE, States.Num());
+    View.DefaultChildIndices.Init(INDEX_NONE, States.Num());
+
+    for (int32& RootDefault : View.RootDefaults)
+    {
+        RootDefault = INDEX_NONE;
+    }
+
+    // Shared sub-states first, so the archetype's own replace them. Problems with a sub-state
+    // are only reported in the view it was registered for, not once per archetype.
+    for (const bool bOwn : { false, true })
+    {
+        if (bOwn && View.Name.IsNone())
+        {
+            break;
+        }
+
+        for (int32 Index = 0; Index < States.Num(); Index++)
+        {
+            const FAIBuilderSubStateDesc& Desc = States[Index];
+            if (Desc.Archetype != (bOwn ? View.Name : NAME_None))
+            {
+                continue;
+            }
+
+            int32& PathIndex = View.PathToIndex.FindOrAdd(Desc.Path, INDEX_NONE);
+            if (PathIndex != INDEX_NONE && States[PathIndex].Archetype == Desc.Archetype)
+            {
+                if (Desc.Archetype == View.Name)
+                {
+                    UE_LOG(LogAIBuilder, Warning, TEXT("Sub-state %s is registered twice"), Desc.PathString);
+                }
+                continue;
+            }
+
+            PathIndex = Index;
+        }
+    }
+
+    TArray<int32> Members;
+    View.PathToIndex.GenerateValueArray(Members);
+    Members.Sort();
+
+    const UEnum* StateEnum = StaticEnum<EAIBuilderState>();
+
+    for (const int32 Index : Members)
+    {
+        const FAIBuilderSubStateDesc& Desc = States[Index];
+        const bool bReport = Desc.Archetype == View.Name;
+        const FString Path = Desc.PathString;
+        const FString RootName = StateEnum->GetNameStringByValue(static_cast<int64>(Desc.RootState));
+
+        if (bReport && !Path.StartsWith(RootName + TEXT(".")))
+        {
+            UE_LOG(LogAIBuilder, Warning, TEXT("Sub-state %s does not start with its state %s"), *Path, *RootName);
+        }
+
+        // "Attack.Melee.Combo" lives below "Attack.Melee", "Attack.Melee" directly below Attack
+        int32 LastDot;
+        if (Path.FindLastChar(TEXT('.'), LastDot))
+        {
+            const FString ParentPath = Path.Left(LastDot);
+            if (ParentPath != RootName)
+            {
+                if (const int32* ParentIndex = View.PathToIndex.Find(FName(*ParentPath)))
+                {
+                    View.ParentIndices[Index] = *ParentIndex;
+                }
+                else if (bReport)
+                {
+                    UE_LOG(LogAIBuilder, Warning, TEXT("Sub-state %s has no registered parent %s, attaching it to %s"),
+                           *Path, *ParentPath, *RootName);
+                }
+            }
+        }
+
+        if (!Desc.bIsDefault)
+        {
+            continue;
+        }
+
+        const int32 ParentIndex = View.ParentIndices[Index];
+        int32& DefaultIndex = ParentIndex != INDEX_NONE
+            ? View.DefaultChildIndices[ParentIndex]
+            : View.RootDefaults[static_cast<int32>(Desc.RootState)];
+
+        // An archetype's own default wins over a shared one
+        if (DefaultIndex != INDEX_NONE && !(bReport && States[DefaultIndex].Archetype != View.Name))
+        {
+            if (bReport)
+            {
+                UE_LOG(LogAIBuilder, Warning, TEXT("Sub-state %s is another default next to %s, ignoring it as default"),
+                       *Path, States[DefaultIndex].PathString);
+            }
+            continue;
+        }
+
+        DefaultIndex = Index;
+    }
+}
+
+const FAIBuilderSubStateRegistry::FArchetypeView& FAIBuilderSubStateRegistry::GetArchetypeView(FName Archetype)
+{
+    Finalize();
+
+    const int32* ViewIndex = ArchetypeToView.Find(Archetype);
+    return ArchetypeViews[ViewIndex ? *ViewIndex : 0];
+}
+
+int32 FAIBuilderSubStateRegistry::Find(FName Archetype, FName Path)
+{
+    const int32* Index = GetArchetypeView(Archetype).PathToIndex.Find(Path);
+    return Index ? *Index : INDEX_NONE;
+}
+
+int32 FAIBuilderSubStateRegistry::GetDefaultLeaf(FName Archetype, int32 Index)
+{
+    const FArchetypeView& View = GetArchetypeView(Archetype);
+
+    // Parents are always resolved to existing entries, so this cannot cycle
+    while (Index != INDEX_NONE && View.DefaultChildIndices[Index] != INDEX_NONE)
+    {
+        Index = View.DefaultChildIndices[Index];
+    }
+
+    return Index;
+}
+
+int32 FAIBuilderSubStateRegistry::GetDefaultLeaf(FName Archetype, EAIBuilderState RootState)
+{
+    return GetDefaultLeaf(Archetype, GetArchetypeView(Archetype).RootDefaults[static_cast<int32>(RootState)]);
+}
+
+void FAIBuilderSubStateRegistry::GetChain(FName Archetype, int32 Index, TArray<int32, TInlineAllocator<4>>& OutChain)
+{
+    const FArchetypeView& View = GetArchetypeView(Archetype);
+
+    OutChain.Reset();
+    for (; Index != INDEX_NONE; Index = View.ParentIndices[Index])
+    {
+        OutChain.Add(Index);
+    }
+
+    Algo::Reverse(OutChain);
+}
@@ -0,0 +1,130 @@
+// AIBuilderVisionCone.cpp - Vectorized view cone implementation
+#include "Components/AIBuilderVisionCone.h"
+#include "Math/VectorRegister.h"
+
+namespace AIBuilderVisionCone
+{
+    // Far enough that its squared distance overflows to infinity and fails every range test
+    constexpr float PaddingCoordinate = 1.0e30f;
+}
+
+void FAIBuilderPositionSoA::Reset()
+{
+    X.Reset();
+    Y.Reset();
+    Z.Reset();
+    NumPositions = 0;
+}
+
+void FAIBuilderPositionSoA::Add(const FVector& Location)
+{
+    // Overwrite the padding slot if there is one, otherwise open a new group of four
+    if (NumPositions == X.Num())
+    {
+        X.AddUninitialized(4);
+        Y.AddUninitialized(4);
+        Z.AddUninitialized(4);
+
+        for (int32 i = NumPositions; i < X.Num(); i++)
+        {
+            X[i] = AIBuilderVisionCone::PaddingCoordinate;
+            Y[i] = AIBuilderVisionCone::PaddingCoordinate;
+            Z[i] = AIBuilderVisionCone::PaddingCoordinate;
+        }
+    }
+
+    X[NumPositions] = static_cast<float>(Location.X);
+    Y[NumPositions] = static_cast<float>(Location.Y);
+    Z[NumPositions] = static_cast<float>(Location.Z);
+    NumPositions++;
+}
+
+FAIBuilderVisionCone::FAIBuilderVisionCone()
+    : Origin(FVector3f::ZeroVector)
+    , Forward(FVector3f::ForwardVector)
+    , CosHalfAngle(1.0f)
+    , RangeSquared(0.0f)
+{
+}
+
+FAIBuilderVisionCone::FAIBuilderVisionCone(const FVector& InOrigin, const FVector& InForward, float SightAngleDegrees, float Range)
+    : Origin(InOrigin)
+    , Forward(InForward.GetSafeNormal())
+    , CosHalfAngle(FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(SightAngleDegrees * 0.5f, 0.0f, 180.0f))))
+    , RangeSquared(FMath::Square(Range))
+{
+}
+
+uint32 FAIBuilderVisionCone::TestGroup(const FAIBuilderPositionSoA& Targets, int32 Index) const
+{
+    const VectorRegister4Float DeltaX = VectorSubtract(VectorLoadAligned(&Targets.X[Index]), VectorSetFloat1(Origin.X));
+    const VectorRegister4Float DeltaY = VectorSubtract(VectorLoadAligned(&Targets.Y[Index]), VectorSetFloat1(Origin.Y));
+    const VectorRegister4Float DeltaZ = VectorSubtract(VectorLoadAligned(&Targets.Z[Index]), VectorSetFloat1(Origin.Z));
+
+    VectorRegister4Float DistSquared = VectorMultiply(DeltaX, DeltaX);
+    DistSquared = VectorMultiplyAdd(DeltaY, DeltaY, DistSquared);
+    DistSquared = VectorMultiplyAdd(DeltaZ, DeltaZ, DistSquared);
+
+    VectorRegister4Float Dot = VectorMultiply(DeltaX, VectorSetFloat1(Forward.X));
+    Dot = VectorMultiplyAdd(DeltaY, VectorSetFloat1(Forward.Y), Dot);
+    Dot = VectorMultiplyAdd(DeltaZ, VectorSetFloat1(Forward.Z), Dot);
+
+    const VectorRegister4Float InRange = VectorCompareLE(DistSquared, VectorSetFloat1(RangeSquared));
+
+    // dot(F, D) >= cos * |D| without the square root, by comparing squares and
+    // handling the sign of each side separately
+    const VectorRegister4Float DotSquared = VectorMultiply(Dot, Dot);
+    const VectorRegister4Float Threshold = VectorMultiply(DistSquared, VectorSetFloat1(CosHalfAngle * CosHalfAngle));
+    const VectorRegister4Float InFront = VectorCompareGE(Dot, VectorZeroFloat());
+
+    VectorRegister4Float InCone;
+    if (CosHalfAngle >= 0.0f)
+    {
+        // Cone of at most 180 degrees, target must be in front and inside the angle
+        InCone = VectorBitwiseAnd(InFront, VectorCompareGE(DotSquared, Threshold));
+    }
+    else
+    {
+        // Wider cone, anything in front passes and targets behind only near the side
+        InCone = VectorBitwiseOr(InFront, VectorCompareLE(DotSquared, Threshold));
+    }
+
+    return static_cast<uint32>(VectorMaskBits(VectorBitwiseAnd(InRange, InCone)));
+}
+
+void FAIBuilderVisionCone::FilterTargets(const FAIBuilderPositionSoA& Targets, TArray<int32>& OutIndices) const
+{
+    for (int32 Index = 0; Index < Targets.NumPadded(); Index += 4)
+    {
+        uint32 Mask = TestGroup(Targets, Index);
+        while (Mask)
+        {
+            const uint32 Lane = FMath::CountTrailingZeros(Mask);
+            OutIndices.Add(Index + Lane);
+            Mask &= Mask - 1;
+        }
+    }
+}
+
+int32 FAIBuilderVisionCone::GetMaskWordsPerRow(const FAIBuilderPositionSoA& Targets)
+{
+    return FMath::DivideAndRoundUp(Targets.NumPadded(), 32);
+}
+
+void FAIBuilderVisionCone::FilterTargetsBatch(TConstArrayView<FAIBuilderVisionCone> Viewers, const FAIBuilderPositionSoA& Targets, TArray<uint32>& OutMasks)
+{
+    const int32 WordsPerRow = GetMaskWordsPerRow(Targets);
+    OutMasks.SetNumZeroed(Viewers.Num() * WordsPerRow);
+
+    for (int32 ViewerIndex = 0; ViewerIndex < Viewers.Num(); ViewerIndex++)
+    {
+        const FAIBuilderVisionCone& Viewer = Viewers[ViewerIndex];
+        uint32* Row = OutMasks.GetData() + ViewerIndex * WordsPerRow;
+
+        // Eight groups of four fill one 32 bit word
+        for (int32 Index = 0; Index < Targets.NumPadded(); Index += 4)
+        {
+            Row[Index / 32] |= Viewer.TestGroup(Targets, Index) << (Index % 32);
+        }
+    }
+}
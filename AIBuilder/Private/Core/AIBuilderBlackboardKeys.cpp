@@ -0,0 +1,84 @@
+// AIBuilderBlackboardKeys.cpp - Blackboard key cache implementation
+#include "Core/AIBuilderBlackboardKeys.h"
+#include "BehaviorTree/BlackboardData.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+#include "GameFramework/Actor.h"
+#include "AIBuilder.h"
+
+bool FAIBuilderBlackboardKeys::Resolve(const UBlackboardComponent* Blackboard)
+{
+    const UBlackboardData* Asset = Blackboard ? Blackboard->GetBlackboardAsset() : nullptr;
+    if (!Asset)
+    {
+        return false;
+    }
+
+    if (Asset == ResolvedAsset.Get())
+    {
+        return true;
+    }
+
+    static const FName TargetActorName(TEXT("TargetActor"));
+    static const FName TargetLocationName(TEXT("TargetLocation"));
+    static const FName HasTargetName(TEXT("HasTarget"));
+
+    ResolvedAsset = Asset;
+    TargetActor = Blackboard->GetKeyID(TargetActorName);
+    TargetLocation = Blackboard->GetKeyID(TargetLocationName);
+    HasTarget = Blackboard->GetKeyID(HasTargetName);
+
+    UE_LOG(LogAIBuilder, Verbose, TEXT("Resolved blackboard keys of %s"), *Asset->GetName());
+    return true;
+}
+
+void FAIBuilderBlackboardKeys::SetTarget(UBlackboardComponent* Blackboard, AActor* Target)
+{
+    if (!Resolve(Blackboard))
+    {
+        return;
+    }
+
+    SetObject(Blackboard, TargetActor, Target);
+    SetBool(Blackboard, HasTarget, Target != nullptr);
+
+    if (Target)
+    {
+        SetVector(Blackboard, TargetLocation, Target->GetActorLocation());
+    }
+}
+
+AActor* FAIBuilderBlackboardKeys::GetTarget(const UBlackboardComponent* Blackboard)
+{
+    if (!Resolve(Blackboard) || TargetActor == FBlackboard::InvalidKey)
+    {
+        return nullptr;
+    }
+
+    return Cast<AActor>(Blackboard->GetValue<UBlackboardKeyType_Object>(TargetActor));
+}
+
+void FAIBuilderBlackboardKeys::SetObject(UBlackboardComponent* Blackboard, FBlackboard::FKey Key, UObject* Value)
+{
+    if (Key != FBlackboard::InvalidKey && Blackboard->GetValue<UBlackboardKeyType_Object>(Key) != Value)
+    {
+        Blackboard->SetValue<UBlackboardKeyType_Object>(Key, Value);
+    }
+}
+
+void FAIBuilderBlackboardKeys::SetVector(UBlackboardComponent* Blackboard, FBlackboard::FKey Key, const FVector& Value)
+{
+    if (Key != FBlackboard::InvalidKey && !Blackboard->GetValue<UBlackboardKeyType_Vector>(Key).Equals(Value))
+    {
+        Blackboard->SetValue<UBlackboardKeyType_Vector>(Key, Value);
+    }
+}
+
+void FAIBuilderBlackboardKeys::SetBool(UBlackboardComponent* Blackboard, FBlackboard::FKey Key, bool Value)
+{
+    if (Key != FBlackboard::InvalidKey && Blackboard->GetValue<UBlackboardKeyType_Bool>(Key) != Value)
+    {
+        Blackboard->SetValue<UBlackboardKeyType_Bool>(Key, Value);
+    }
+}
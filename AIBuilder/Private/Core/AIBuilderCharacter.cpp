@@ -8,6 +8,7 @@
 #include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "BehaviorTree/BehaviorTreeComponent.h"
+#include "Subsystems/AIBuilderTickManagerSubsystem.h"
 #include "AIBuilder.h"
 
 AAIBuilderCharacter::AAIBuilderCharacter()
@@ -37,18 +38,43 @@ AAIBuilderCharacter::AAIBuilderCharacter()
     // Initialize variables
     CurrentTarget = nullptr;
     LastUpdateTime = 0.0f;
+    AITickManager = nullptr;
+    AITickIndex = INDEX_NONE;
 }
 
 void AAIBuilderCharacter::BeginPlay()
 {
     Super::BeginPlay();
     InitializeAI();
+
+    if (bUseAITickManager)
+    {
+        if (UAIBuilderTickManagerSubsystem* TickManager = GetWorld()->GetSubsystem<UAIBuilderTickManagerSubsystem>())
+        {
+            TickManager->RegisterCharacter(this);
+        }
+    }
+}
+
+void AAIBuilderCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (AITickManager)
+    {
+        AITickManager->UnregisterCharacter(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void AAIBuilderCharacter::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
-    UpdateAIState(DeltaTime);
+
+    // Still ticking for Event Tick, the AI update already runs on the tick manager
+    if (!AITickManager)
+    {
+        UpdateAIState(DeltaTime);
+    }
 }
 
 void AAIBuilderCharacter::InitializeAI()
@@ -59,10 +85,24 @@ void AAIBuilderCharacter::InitializeAI()
         if (BlackboardAsset)
         {
             AIController->UseBlackboard(BlackboardAsset);
-            BlackboardComponent = AIController->GetBlackboardComponent();
         }
 
-        SetupPerception();
+        // The controller may have set up its own blackboard, either way there is only one
+        if (UBlackboardComponent* ControllerBlackboard = AIController->GetBlackboardComponent())
+        {
+            BlackboardComponent = ControllerBlackboard;
+        }
+
+        BlackboardKeys.Resolve(BlackboardComponent);
+
+        if (UsesUnifiedPerception())
+        {
+            SetupUnifiedPerception();
+        }
+        else
+        {
+            SetupPerception();
+        }
         
         if (BehaviorTree)
         {
@@ -102,22 +142,78 @@ void AAIBuilderCharacter::SetupPerception()
     }
 }
 
+void AAIBuilderCharacter::SetupUnifiedPerception()
+{
+    // No senses are configured, so the perception system has nothing to process for us
+    if (AIPerceptionComponent)
+    {
+        AIPerceptionComponent->Deactivate();
+    }
+
+    if (SensorComponent)
+    {
+        SensorComponent->OnActorDetected.AddUniqueDynamic(this, &AAIBuilderCharacter::OnSensorActorDetected);
+        SensorComponent->OnActorLost.AddUniqueDynamic(this, &AAIBuilderCharacter::OnSensorActorLost);
+    }
+}
+
+void AAIBuilderCharacter::OnSensorActorDetected(AActor* DetectedActor, ESensorType SensorType, float Confidence)
+{
+    RefreshTargetFromSensor();
+}
+
+void AAIBuilderCharacter::OnSensorActorLost(AActor* LostActor, ESensorType SensorType)
+{
+    RefreshTargetFromSensor();
+}
+
+void AAIBuilderCharacter::RefreshTargetFromSensor()
+{
+    if (!SensorComponent)
+    {
+        return;
+    }
+
+    // Sticking with a target that is still detected avoids flipping between similar detections
+    if (!CurrentTarget || !SensorComponent->HasDetectedActor(CurrentTarget))
+    {
+        const FAISensorData* BestDetection = SensorComponent->GetBestDetection();
+        SetCurrentTarget(BestDetection ? BestDetection->DetectedActor : nullptr);
+    }
+
+    // SetCurrentTarget skips unchanged targets, the location still moves
+    if (CurrentTarget && BlackboardKeys.Resolve(BlackboardComponent))
+    {
+        FAIBuilderBlackboardKeys::SetVector(BlackboardComponent, BlackboardKeys.TargetLocation, CurrentTarget->GetActorLocation());
+    }
+}
+
 void AAIBuilderCharacter::UpdateAIState(float DeltaTime)
 {
+    // Only reached without the tick manager
     LastUpdateTime += DeltaTime;
     
-    // Update every 0.1 seconds for performance
-    if (LastUpdateTime >= 0.1f)
+    if (LastUpdateTime >= AIUpdateInterval)
     {
-        if (StateMachine)
-        {
-            StateMachine->UpdateState(DeltaTime);
-        }
-        
+        UpdateAI(LastUpdateTime);
         LastUpdateTime = 0.0f;
     }
 }
 
+void AAIBuilderCharacter::UpdateAI(float ElapsedTime)
+{
+    // Sensors run on UAIBuilderSensorSchedulerSubsystem, here their results are applied
+    if (UsesUnifiedPerception())
+    {
+        RefreshTargetFromSensor();
+    }
+
+    if (StateMachine)
+    {
+        StateMachine->UpdateState(ElapsedTime);
+    }
+}
+
 void AAIBuilderCharacter::OnPerceptionUpdated(const TArray<AActor*>& UpdatedActors)
 {
     for (AActor* Actor : UpdatedActors)
@@ -177,10 +273,34 @@ AActor* AAIBuilderCharacter::GetCurrentTarget() const
 
 void AAIBuilderCharacter::SetCurrentTarget(AActor* NewTarget)
 {
+    if (NewTarget == CurrentTarget)
+    {
+        return;
+    }
+
+    AActor* OldTarget = CurrentTarget;
+    if (OldTarget)
+    {
+        OldTarget->OnDestroyed.RemoveDynamic(this, &AAIBuilderCharacter::OnCurrentTargetDestroyed);
+    }
+
     CurrentTarget = NewTarget;
+
+    // Listeners rely on OnTargetChanged, so a destroyed target has to clear itself
+    if (CurrentTarget)
+    {
+        CurrentTarget->OnDestroyed.AddUniqueDynamic(this, &AAIBuilderCharacter::OnCurrentTargetDestroyed);
+    }
     
-    if (BlackboardComponent)
+    BlackboardKeys.SetTarget(BlackboardComponent, CurrentTarget);
+
+    OnTargetChanged.Broadcast(OldTarget, CurrentTarget);
+}
+
+void AAIBuilderCharacter::OnCurrentTargetDestroyed(AActor* DestroyedActor)
+{
+    if (DestroyedActor == CurrentTarget)
     {
-        BlackboardComponent->SetValueAsObject(TEXT("TargetActor"), CurrentTarget);
+        SetCurrentTarget(nullptr);
     }
 }
\ No newline at end of file
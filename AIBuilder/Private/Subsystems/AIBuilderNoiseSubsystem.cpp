@@ -0,0 +1,137 @@
+// AIBuilderNoiseSubsystem.cpp - Noise bus implementation
+#include "Subsystems/AIBuilderNoiseSubsystem.h"
+#include "Engine/World.h"
+#include "AIBuilder.h"
+#include "AIBuilderStats.h"
+
+UAIBuilderNoiseSubsystem::UAIBuilderNoiseSubsystem()
+{
+    NextSlot = 0;
+    NextSequence = 1;
+}
+
+bool UAIBuilderNoiseSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAIBuilderNoiseSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // Sequence 0 marks a slot that has never held an event
+    Events.SetNum(Capacity);
+}
+
+void UAIBuilderNoiseSubsystem::ReportNoise(FVector Location, float Volume, AActor* Instigator)
+{
+    const int32 Slot = NextSlot;
+    NextSlot = (NextSlot + 1) % Capacity;
+
+    FAIBuilderNoiseEvent& NoiseEvent = Events[Slot];
+
+    // Drop the overwritten event's entry, otherwise cells nobody queries would grow forever
+    if (NoiseEvent.Sequence != 0)
+    {
+        RemoveCellEntry(NoiseEvent.Cell, Slot, NoiseEvent.Sequence);
+    }
+
+    NoiseEvent.Location = Location;
+    NoiseEvent.Volume = Volume;
+    NoiseEvent.TimeStamp = GetWorld()->GetTimeSeconds();
+    NoiseEvent.Instigator = Instigator;
+    NoiseEvent.Sequence = NextSequence++;
+    NoiseEvent.Cell = GetCellCoord(Location);
+
+    Cells.FindOrAdd(NoiseEvent.Cell).Add({ Slot, NoiseEvent.Sequence });
+    INC_DWORD_STAT(STAT_AIBuilder_NoiseEvents);
+
+    UE_LOG(LogAIBuilder, Verbose, TEXT("Noise event reported at %s with volume %f"),
+           *Location.ToString(), Volume);
+}
+
+void UAIBuilderNoiseSubsystem::QueryNoise(const FVector& ListenerLocation, float Range, TFunctionRef<void(const FAIBuilderNoiseEvent&)> Visitor)
+{
+    const float CurrentTime = GetWorld()->GetTimeSeconds();
+    const FIntPoint MinCell = GetCellCoord(ListenerLocation - FVector(Range));
+    const FIntPoint MaxCell = GetCellCoord(ListenerLocation + FVector(Range));
+    const double RangeSquared = FMath::Square(Range);
+
+    // Visitors may report new noise, so collect first and only call them once the cells are no longer referenced
+    TArray<int32, TInlineAllocator<32>> AudibleSlots;
+
+    for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+    {
+        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+        {
+            const FIntPoint Cell(X, Y);
+            TArray<FCellEntry>* Entries = Cells.Find(Cell);
+            if (!Entries)
+            {
+                continue;
+            }
+
+            for (int32 i = Entries->Num() - 1; i >= 0; i--)
+            {
+                const FCellEntry& Entry = (*Entries)[i];
+                const FAIBuilderNoiseEvent& NoiseEvent = Events[Entry.Slot];
+
+                // Overwritten by a newer event or too old to be heard
+                if (NoiseEvent.Sequence != Entry.Sequence || CurrentTime - NoiseEvent.TimeStamp > EventLifetime)
+                {
+                    Entries->RemoveAtSwap(i, 1, EAllowShrinking::No);
+                    continue;
+                }
+
+                if (FVector::DistSquared(ListenerLocation, NoiseEvent.Location) <= RangeSquared)
+                {
+                    AudibleSlots.Add(Entry.Slot);
+                }
+            }
+
+            if (Entries->Num() == 0)
+            {
+                Cells.Remove(Cell);
+            }
+        }
+    }
+
+    for (int32 Slot : AudibleSlots)
+    {
+        Visitor(Events[Slot]);
+    }
+}
+
+void UAIBuilderNoiseSubsystem::RemoveCellEntry(const FIntPoint& Cell, int32 Slot, uint32 Sequence)
+{
+    TArray<FCellEntry>* Entries = Cells.Find(Cell);
+    if (!Entries)
+    {
+        return;
+    }
+
+    // A query may already have pruned it
+    const int32 Index = Entries->IndexOfByPredicate([Slot, Sequence](const FCellEntry& Entry)
+    {
+        return Entry.Slot == Slot && Entry.Sequence == Sequence;
+    });
+
+    if (Index != INDEX_NONE)
+    {
+        Entries->RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    }
+
+    if (Entries->Num() == 0)
+    {
+        Cells.Remove(Cell);
+    }
+}
+
+FIntPoint UAIBuilderNoiseSubsystem::GetCellCoord(const FVector& Location) const
+{
+    const double InvCellSize = 1.0 / FMath::Max(CellSize, 1.0f);
+    return FIntPoint(
+        FMath::FloorToInt32(Location.X * InvCellSize),
+        FMath::FloorToInt32(Location.Y * InvCellSize)
+    );
+}
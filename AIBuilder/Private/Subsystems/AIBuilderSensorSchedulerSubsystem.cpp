@@ -0,0 +1,236 @@
+// AIBuilderSensorSchedulerSubsystem.cpp - Budgeted sensor scheduler implementation
+#include "Subsystems/AIBuilderSensorSchedulerSubsystem.h"
+#include "Components/AIBuilderSensorComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/App.h"
+#include "HAL/PlatformTime.h"
+#include "Async/ParallelFor.h"
+#include "AIBuilder.h"
+#include "AIBuilderStats.h"
+
+UAIBuilderSensorSchedulerSubsystem::UAIBuilderSensorSchedulerSubsystem()
+{
+    Cursor = 0;
+    bIsTicking = false;
+
+    // Full rate up close, no touch at mid range, and no sight once dormant
+    LODTiers.Emplace(2500.0f, 1.0f, true, true, true);
+    LODTiers.Emplace(6000.0f, 2.0f, true, true, false);
+    LODTiers.Emplace(12000.0f, 4.0f, true, true, false);
+    LODTiers.Emplace(UE_BIG_NUMBER, 10.0f, false, true, false);
+}
+
+bool UAIBuilderSensorSchedulerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UAIBuilderSensorSchedulerSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UAIBuilderSensorSchedulerSubsystem, STATGROUP_Tickables);
+}
+
+void UAIBuilderSensorSchedulerSubsystem::RegisterSensor(UAIBuilderSensorComponent* Sensor)
+{
+    if (!Sensor)
+    {
+        return;
+    }
+
+    const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+    // Random phase so sensors registered on the same frame don't all fire together
+    FScheduledSensor& Entry = Sensors.AddDefaulted_GetRef();
+    Entry.Sensor = Sensor;
+    Entry.NextUpdateTime = CurrentTime + FMath::FRandRange(0.0f, Sensor->UpdateFrequency);
+    Entry.LastUpdateTime = CurrentTime;
+
+    Sensor->SetComponentTickEnabled(false);
+
+    UE_LOG(LogAIBuilder, Verbose, TEXT("Sensor scheduler registered %s"), *GetNameSafe(Sensor->GetOwner()));
+}
+
+void UAIBuilderSensorSchedulerSubsystem::UnregisterSensor(UAIBuilderSensorComponent* Sensor)
+{
+    const int32 Index = Sensors.IndexOfByPredicate([Sensor](const FScheduledSensor& Entry)
+    {
+        return Entry.Sensor == Sensor;
+    });
+
+    if (Index == INDEX_NONE)
+    {
+        return;
+    }
+
+    // Sensor callbacks can destroy actors mid-tick, so only clear the slot then
+    if (bIsTicking)
+    {
+        Sensors[Index].Sensor.Reset();
+    }
+    else
+    {
+        Sensors.RemoveAtSwap(Index);
+    }
+}
+
+int32 UAIBuilderSensorSchedulerSubsystem::GetNumRegisteredSensors() const
+{
+    return Sensors.Num();
+}
+
+const FAISensorSchedulerFrameStats& UAIBuilderSensorSchedulerSubsystem::GetLastFrameStats() const
+{
+    return LastFrameStats;
+}
+
+void UAIBuilderSensorSchedulerSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+    AIBUILDER_SCOPE_CYCLE_COUNTER(STAT_AIBuilder_SensorScheduler);
+
+    LastFrameStats = FAISensorSchedulerFrameStats();
+    LastFrameStats.bParallel = bParallelSensorEvaluation;
+
+    if (Sensors.Num() == 0)
+    {
+        return;
+    }
+
+    GatherViewLocations();
+
+    const double CurrentTime = GetWorld()->GetTimeSeconds();
+    const double BudgetEnd = FPlatformTime::Seconds() + FrameBudgetMs * 0.001;
+    const int32 BatchSize = FMath::Max(ParallelBatchSize, 1);
+
+    int32 Remaining = Sensors.Num();
+    int32 Index = Cursor % Sensors.Num();
+
+    TGuardValue<bool> TickingGuard(bIsTicking, true);
+
+    // The budget is checked between batches, so one batch is the scheduling granularity.
+    // At least one batch with due sensors always runs, however small the budget.
+    while (Remaining > 0 && Sensors.Num() > 0 && (LastFrameStats.SensorsUpdated == 0 || FPlatformTime::Seconds() < BudgetEnd))
+    {
+        // Pick the next due sensors and snapshot their inputs on the game thread
+        double PhaseStart = FPlatformTime::Seconds();
+        Batch.Reset();
+
+        while (Batch.Num() < BatchSize && Remaining-- > 0 && Sensors.Num() > 0)
+        {
+            UAIBuilderSensorComponent* Sensor = Sensors[Index].Sensor.Get();
+            if (!Sensor)
+            {
+                // Unregistered while ticking, or destroyed without EndPlay reaching us
+                Sensors.RemoveAtSwap(Index);
+                Index = Sensors.Num() > 0 ? Index % Sensors.Num() : 0;
+                continue;
+            }
+
+            FScheduledSensor& Entry = Sensors[Index];
+            Index = (Index + 1) % Sensors.Num();
+
+            if (CurrentTime < Entry.NextUpdateTime)
+            {
+                continue;
+            }
+
+            // Significance is only evaluated for sensors that are due anyway
+            const int32 TierIndex = ComputeLODTier(Sensor);
+            const FAISensorLODTier* Tier = LODTiers.IsValidIndex(TierIndex) ? &LODTiers[TierIndex] : nullptr;
+            const float IntervalScale = Tier ? Tier->UpdateIntervalScale : 1.0f;
+
+            Sensor->BeginSensorUpdate(CurrentTime - Entry.LastUpdateTime, Tier);
+            Sensor->CurrentLODTier = TierIndex;
+            Entry.LastUpdateTime = CurrentTime;
+            Entry.NextUpdateTime = CurrentTime + Sensor->UpdateFrequency * IntervalScale;
+
+            Batch.Add(Sensor);
+        }
+
+        double PhaseEnd = FPlatformTime::Seconds();
+        LastFrameStats.GatherMs += (PhaseEnd - PhaseStart) * 1000.0;
+        PhaseStart = PhaseEnd;
+
+        // Cone tests and confidence only read each sensor's own snapshot
+        ParallelFor(Batch.Num(), [this](int32 BatchIndex)
+        {
+            Batch[BatchIndex]->EvaluateSensorUpdate();
+        }, bParallelSensorEvaluation ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+        PhaseEnd = FPlatformTime::Seconds();
+        LastFrameStats.EvaluateMs += (PhaseEnd - PhaseStart) * 1000.0;
+        PhaseStart = PhaseEnd;
+
+        // Traces, detection table merges and the detected/lost broadcasts stay on the game thread.
+        // Callbacks may destroy other sensors in the batch, so check each one again.
+        for (UAIBuilderSensorComponent* Sensor : Batch)
+        {
+            if (IsValid(Sensor))
+            {
+                Sensor->FinishSensorUpdate();
+                LastFrameStats.SensorsUpdated++;
+            }
+        }
+
+        LastFrameStats.ApplyMs += (FPlatformTime::Seconds() - PhaseStart) * 1000.0;
+    }
+
+    Batch.Reset();
+    Cursor = Index;
+
+    INC_DWORD_STAT_BY(STAT_AIBuilder_SensorsUpdated, LastFrameStats.SensorsUpdated);
+}
+
+void UAIBuilderSensorSchedulerSubsystem::GatherViewLocations()
+{
+    ViewLocations.Reset();
+
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        if (APlayerController* PlayerController = It->Get())
+        {
+            FVector ViewLocation;
+            FRotator ViewRotation;
+            PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+            ViewLocations.Add(ViewLocation);
+        }
+    }
+}
+
+int32 UAIBuilderSensorSchedulerSubsystem::ComputeLODTier(const UAIBuilderSensorComponent* Sensor) const
+{
+    const AActor* Owner = Sensor->GetOwner();
+
+    // Nobody to be significant to, keep full fidelity
+    if (LODTiers.Num() == 0 || ViewLocations.Num() == 0 || !Owner)
+    {
+        return INDEX_NONE;
+    }
+
+    const FVector Location = Owner->GetActorLocation();
+    double NearestDistanceSquared = TNumericLimits<double>::Max();
+    for (const FVector& ViewLocation : ViewLocations)
+    {
+        NearestDistanceSquared = FMath::Min(NearestDistanceSquared, FVector::DistSquared(Location, ViewLocation));
+    }
+
+    int32 TierIndex = LODTiers.Num() - 1;
+    for (int32 i = 0; i < LODTiers.Num(); i++)
+    {
+        if (NearestDistanceSquared < FMath::Square(LODTiers[i].MaxDistance))
+        {
+            TierIndex = i;
+            break;
+        }
+    }
+
+    // Nothing is ever rendered without a renderer, so only demote when one exists. Agents within
+    // the first tier stay there, one behind the player is off screen but may be touching them.
+    if (bDemoteOffscreenAgents && TierIndex > 0 && FApp::CanEverRender() && !Owner->WasRecentlyRendered(0.5f))
+    {
+        TierIndex = FMath::Min(TierIndex + 1, LODTiers.Num() - 1);
+    }
+
+    return TierIndex;
+}
@@ -0,0 +1,104 @@
+// AIBuilderSpatialGridSubsystem.cpp - Shared spatial hash implementation
+#include "Subsystems/AIBuilderSpatialGridSubsystem.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "AIBuilder.h"
+#include "AIBuilderStats.h"
+
+UAIBuilderSpatialGridSubsystem::UAIBuilderSpatialGridSubsystem()
+{
+    LastBuildFrame = MAX_uint64;
+}
+
+bool UAIBuilderSpatialGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAIBuilderSpatialGridSubsystem::EnsureUpToDate()
+{
+    if (LastBuildFrame != GFrameCounter)
+    {
+        RebuildGrid();
+        LastBuildFrame = GFrameCounter;
+    }
+}
+
+void UAIBuilderSpatialGridSubsystem::RebuildGrid()
+{
+    AIBUILDER_SCOPE_CYCLE_COUNTER(STAT_AIBuilder_SpatialGridRebuild);
+
+    // Reset keeps the allocations around, so steady state rebuilds don't allocate
+    Entries.Reset();
+    Cells.Reset();
+
+    for (TActorIterator<APawn> It(GetWorld()); It; ++It)
+    {
+        APawn* Pawn = *It;
+        if (!IsValid(Pawn))
+        {
+            continue;
+        }
+
+        FGridEntry& Entry = Entries.AddDefaulted_GetRef();
+        Entry.Actor = Pawn;
+        Entry.Location = Pawn->GetActorLocation();
+        Entry.Cell = GetCellCoord(Entry.Location);
+    }
+
+    Entries.Sort([](const FGridEntry& A, const FGridEntry& B)
+    {
+        return A.Cell.X != B.Cell.X ? A.Cell.X < B.Cell.X : A.Cell.Y < B.Cell.Y;
+    });
+
+    for (int32 i = 0; i < Entries.Num(); i++)
+    {
+        FCellRange& Range = Cells.FindOrAdd(Entries[i].Cell, FCellRange{ i, 0 });
+        Range.Num++;
+    }
+}
+
+void UAIBuilderSpatialGridSubsystem::QuerySphere(const FVector& Center, float Radius, const AActor* IgnoreActor, TArray<FAISensorCandidate>& OutCandidates)
+{
+    EnsureUpToDate();
+
+    const FIntPoint MinCell = GetCellCoord(Center - FVector(Radius));
+    const FIntPoint MaxCell = GetCellCoord(Center + FVector(Radius));
+    const double RadiusSquared = FMath::Square(Radius);
+
+    for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+    {
+        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+        {
+            const FCellRange* Range = Cells.Find(FIntPoint(X, Y));
+            if (!Range)
+            {
+                continue;
+            }
+
+            for (int32 i = Range->Start; i < Range->Start + Range->Num; i++)
+            {
+                const FGridEntry& Entry = Entries[i];
+                if (Entry.Actor != IgnoreActor && FVector::DistSquared(Center, Entry.Location) <= RadiusSquared)
+                {
+                    OutCandidates.Add({ Entry.Actor, Entry.Location });
+                }
+            }
+        }
+    }
+}
+
+int32 UAIBuilderSpatialGridSubsystem::GetNumTrackedPawns() const
+{
+    return Entries.Num();
+}
+
+FIntPoint UAIBuilderSpatialGridSubsystem::GetCellCoord(const FVector& Location) const
+{
+    const double InvCellSize = 1.0 / FMath::Max(CellSize, 1.0f);
+    return FIntPoint(
+        FMath::FloorToInt32(Location.X * InvCellSize),
+        FMath::FloorToInt32(Location.Y * InvCellSize)
+    );
+}
@@ -0,0 +1,248 @@
+// AIBuilderStateBatchSubsystem.cpp - Batched state machine implementation
+#include "Subsystems/AIBuilderStateBatchSubsystem.h"
+#include "Components/AIBuilderStateTable.h"
+#include "Core/AIBuilderCharacter.h"
+#include "Engine/World.h"
+#include "AIBuilder.h"
+#include "AIBuilderStats.h"
+
+UAIBuilderStateBatchSubsystem::UAIBuilderStateBatchSubsystem()
+{
+    bIsTicking = false;
+    bHasStaleSlots = false;
+}
+
+bool UAIBuilderStateBatchSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UAIBuilderStateBatchSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UAIBuilderStateBatchSubsystem, STATGROUP_Tickables);
+}
+
+void UAIBuilderStateBatchSubsystem::RegisterStateMachine(UAIBuilderStateMachine* StateMachine)
+{
+    if (!StateMachine || StateMachine->BatchSubsystem)
+    {
+        return;
+    }
+
+    const int32 Index = Machines.Add(StateMachine);
+    Tables.Add(&StateMachine->GetTransitionTable());
+    States.Add(StateMachine->CurrentState);
+    StateTimers.Add(StateMachine->StateTimer);
+    LastTransitionTimes.Add(StateMachine->LastTransitionTime);
+    TransitionDelays.Add(StateMachine->StateTransitionDelay);
+    TargetDeltas.Add(FVector::ZeroVector);
+    TargetDistancesSquared.Add(0.0f);
+    AttackRangesSquared.Add(0.0f);
+    HasTarget.Add(0);
+    InAttackRange.Add(0);
+    Targets.Add(nullptr);
+
+    StateMachine->BatchSubsystem = this;
+    StateMachine->BatchIndex = Index;
+
+    UE_LOG(LogAIBuilder, Verbose, TEXT("State batch registered %s"), *GetNameSafe(StateMachine->GetOwner()));
+}
+
+void UAIBuilderStateBatchSubsystem::UnregisterStateMachine(UAIBuilderStateMachine* StateMachine)
+{
+    if (!StateMachine || StateMachine->BatchSubsystem != this)
+    {
+        return;
+    }
+
+    const int32 Index = StateMachine->BatchIndex;
+
+    // Hand the timer back so per-agent updates carry on where the batch left off
+    StateMachine->StateTimer = StateTimers[Index];
+    StateMachine->BatchSubsystem = nullptr;
+    StateMachine->BatchIndex = INDEX_NONE;
+
+    // Transition callbacks can destroy agents mid-tick, so only clear the slot then
+    if (bIsTicking)
+    {
+        Machines[Index].Reset();
+        Tables[Index] = nullptr;
+        bHasStaleSlots = true;
+    }
+    else
+    {
+        RemoveSlot(Index);
+    }
+}
+
+void UAIBuilderStateBatchSubsystem::NotifyStateChanged(int32 Index, EAIBuilderState NewState, float TransitionTime)
+{
+    check(Machines.IsValidIndex(Index));
+
+    States[Index] = NewState;
+    StateTimers[Index] = 0.0f;
+    LastTransitionTimes[Index] = TransitionTime;
+}
+
+void UAIBuilderStateBatchSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (Machines.Num() == 0)
+    {
+        return;
+    }
+
+    AIBUILDER_SCOPE_CYCLE_COUNTER(STAT_AIBuilder_StateUpdate);
+
+    {
+        TGuardValue<bool> TickingGuard(bIsTicking, true);
+
+        // The only pass that reads from the agents themselves
+        GatherInputs();
+
+        const int32 NumAgents = Machines.Num();
+
+        // Straight loops over contiguous arrays, simple enough for the compiler to vectorize
+        for (int32 i = 0; i < NumAgents; i++)
+        {
+            StateTimers[i] += DeltaTime;
+        }
+
+        for (int32 i = 0; i < NumAgents; i++)
+        {
+            TargetDistancesSquared[i] = TargetDeltas[i].SizeSquared();
+            InAttackRange[i] = HasTarget[i] & static_cast<uint8>(TargetDistancesSquared[i] <= AttackRangesSquared[i]);
+        }
+
+        // Blueprint and behavior tree readers get the same numbers the transitions below use
+        PublishTargetContexts();
+
+        const float CurrentTime = GetWorld()->GetTimeSeconds();
+        PendingTransitions.Reset();
+
+        for (int32 i = 0; i < NumAgents; i++)
+        {
+            // Still inside the transition delay, ChangeState would reject it anyway
+            if (!Tables[i] || CurrentTime - LastTransitionTimes[i] < TransitionDelays[i])
+            {
+                continue;
+            }
+
+            FAIBuilderCompiledStateTable::FConditionInputs Inputs;
+            Inputs.bHasTarget = HasTarget[i] != 0;
+            Inputs.bInAttackRange = InAttackRange[i] != 0;
+            Inputs.TimeInState = StateTimers[i];
+
+            EAIBuilderState NewState;
+            uint32 ConditionMask;
+            if (Tables[i]->FindTransition(States[i], Inputs, NewState, &ConditionMask))
+            {
+                PendingTransitions.Add({ i, NewState, ConditionMask });
+            }
+        }
+
+        // Only agents that change state are written back, TryChangeState updates our arrays through NotifyStateChanged
+        for (const FPendingTransition& Transition : PendingTransitions)
+        {
+            if (UAIBuilderStateMachine* StateMachine = Machines[Transition.Index].Get())
+            {
+                StateMachine->TryChangeState(Transition.To, EAIBuilderTransitionReason::Rule, Transition.ConditionMask);
+            }
+        }
+
+        // Returns right away for agents without active sub-states
+        for (int32 i = 0; i < NumAgents; i++)
+        {
+            if (UAIBuilderStateMachine* StateMachine = Machines[i].Get())
+            {
+                StateMachine->UpdateSubStates(DeltaTime);
+            }
+        }
+    }
+
+    if (bHasStaleSlots)
+    {
+        RemoveStaleSlots();
+    }
+}
+
+void UAIBuilderStateBatchSubsystem::GatherInputs()
+{
+    for (int32 i = 0; i < Machines.Num(); i++)
+    {
+        UAIBuilderStateMachine* StateMachine = Machines[i].Get();
+        AAIBuilderCharacter* Character = StateMachine ? StateMachine->OwnerCharacter : nullptr;
+
+        if (!Character)
+        {
+            // Destroyed without EndPlay reaching us, or not initialized yet
+            bHasStaleSlots |= StateMachine == nullptr;
+            Tables[i] = nullptr;
+            Targets[i] = nullptr;
+            TargetDeltas[i] = FVector::ZeroVector;
+            HasTarget[i] = 0;
+            continue;
+        }
+
+        // Table, delay and range can be changed from Blueprint at any time
+        Tables[i] = &StateMachine->GetTransitionTable();
+        TransitionDelays[i] = StateMachine->StateTransitionDelay;
+        AttackRangesSquared[i] = FMath::Square(Character->AttackRange);
+
+        AActor* Target = Character->GetCurrentTarget();
+        Targets[i] = Target;
+        HasTarget[i] = Target != nullptr;
+        TargetDeltas[i] = Target ? Target->GetActorLocation() - Character->GetActorLocation() : FVector::ZeroVector;
+    }
+}
+
+void UAIBuilderStateBatchSubsystem::PublishTargetContexts()
+{
+    for (int32 i = 0; i < Machines.Num(); i++)
+    {
+        if (UAIBuilderStateMachine* StateMachine = Machines[i].Get())
+        {
+            StateMachine->SetTargetContext(Targets[i], TargetDeltas[i], TargetDistancesSquared[i], InAttackRange[i] != 0);
+        }
+    }
+}
+
+void UAIBuilderStateBatchSubsystem::RemoveSlot(int32 Index)
+{
+    Machines.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Tables.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    States.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    StateTimers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    LastTransitionTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    TransitionDelays.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    TargetDeltas.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    TargetDistancesSquared.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    AttackRangesSquared.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    HasTarget.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    InAttackRange.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Targets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+    // The last agent moved into the hole
+    if (Machines.IsValidIndex(Index))
+    {
+        if (UAIBuilderStateMachine* Moved = Machines[Index].Get())
+        {
+            Moved->BatchIndex = Index;
+        }
+    }
+}
+
+void UAIBuilderStateBatchSubsystem::RemoveStaleSlots()
+{
+    // Walking backwards keeps swap-removal from skipping entries
+    for (int32 i = Machines.Num() - 1; i >= 0; i--)
+    {
+        if (!Machines[i].IsValid())
+        {
+            RemoveSlot(i);
+        }
+    }
+
+    bHasStaleSlots = false;
+}
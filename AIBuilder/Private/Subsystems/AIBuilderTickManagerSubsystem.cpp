@@ -0,0 +1,157 @@
+// AIBuilderTickManagerSubsystem.cpp - AI tick manager implementation
+#include "Subsystems/AIBuilderTickManagerSubsystem.h"
+#include "Core/AIBuilderCharacter.h"
+#include "Engine/World.h"
+#include "AIBuilder.h"
+#include "AIBuilderStats.h"
+
+UAIBuilderTickManagerSubsystem::UAIBuilderTickManagerSubsystem()
+{
+    NextPhaseBucket = 0;
+    bIsTicking = false;
+    bHasStaleSlots = false;
+}
+
+bool UAIBuilderTickManagerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UAIBuilderTickManagerSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UAIBuilderTickManagerSubsystem, STATGROUP_Tickables);
+}
+
+void UAIBuilderTickManagerSubsystem::RegisterCharacter(AAIBuilderCharacter* Character)
+{
+    if (!Character || Character->AITickManager)
+    {
+        return;
+    }
+
+    const double CurrentTime = GetWorld()->GetTimeSeconds();
+    const int32 NumBuckets = FMath::Max(NumPhaseBuckets, 1);
+    const int32 PhaseBucket = NextPhaseBucket % NumBuckets;
+    NextPhaseBucket = (PhaseBucket + 1) % NumBuckets;
+
+    const int32 Index = Characters.Add(Character);
+    NextUpdateTimes.Add(CurrentTime + Character->AIUpdateInterval * PhaseBucket / NumBuckets);
+    LastUpdateTimes.Add(CurrentTime);
+
+    Character->AITickManager = this;
+    Character->AITickIndex = Index;
+
+    // The AI update was the only thing the native tick did, Blueprint Event Tick still needs it
+    if (!Character->GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(AActor, ReceiveTick)))
+    {
+        Character->SetActorTickEnabled(false);
+    }
+
+    UE_LOG(LogAIBuilder, Verbose, TEXT("AI tick manager registered %s in phase bucket %d"), *Character->GetName(), PhaseBucket);
+}
+
+void UAIBuilderTickManagerSubsystem::UnregisterCharacter(AAIBuilderCharacter* Character)
+{
+    if (!Character || Character->AITickManager != this)
+    {
+        return;
+    }
+
+    const int32 Index = Character->AITickIndex;
+    Character->AITickManager = nullptr;
+    Character->AITickIndex = INDEX_NONE;
+
+    // AI updates can destroy characters mid-tick, so only clear the slot then
+    if (bIsTicking)
+    {
+        Characters[Index].Reset();
+        bHasStaleSlots = true;
+    }
+    else
+    {
+        RemoveSlot(Index);
+    }
+}
+
+void UAIBuilderTickManagerSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (Characters.Num() == 0)
+    {
+        return;
+    }
+
+    AIBUILDER_SCOPE_CYCLE_COUNTER(STAT_AIBuilder_TickManager);
+
+    {
+        TGuardValue<bool> TickingGuard(bIsTicking, true);
+
+        const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+        // Characters registered during the loop wait for the next frame
+        const int32 NumCharacters = Characters.Num();
+        for (int32 i = 0; i < NumCharacters; i++)
+        {
+            if (NextUpdateTimes[i] > CurrentTime)
+            {
+                continue;
+            }
+
+            AAIBuilderCharacter* Character = Characters[i].Get();
+            if (!Character)
+            {
+                bHasStaleSlots = true;
+                continue;
+            }
+
+            // Stepping from the scheduled time keeps the phase. After a hitch, start over from now.
+            const float Interval = FMath::Max(Character->AIUpdateInterval, 0.0f);
+            NextUpdateTimes[i] += Interval;
+            if (NextUpdateTimes[i] <= CurrentTime)
+            {
+                NextUpdateTimes[i] = CurrentTime + Interval;
+            }
+
+            const float ElapsedTime = static_cast<float>(CurrentTime - LastUpdateTimes[i]);
+            LastUpdateTimes[i] = CurrentTime;
+
+            Character->UpdateAI(ElapsedTime);
+        }
+    }
+
+    if (bHasStaleSlots)
+    {
+        RemoveStaleSlots();
+    }
+}
+
+void UAIBuilderTickManagerSubsystem::RemoveSlot(int32 Index)
+{
+    Characters.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    NextUpdateTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    LastUpdateTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+    // The last character moved into the hole
+    if (Characters.IsValidIndex(Index))
+    {
+        if (AAIBuilderCharacter* Moved = Characters[Index].Get())
+        {
+            Moved->AITickIndex = Index;
+        }
+    }
+}
+
+void UAIBuilderTickManagerSubsystem::RemoveStaleSlots()
+{
+    // Walking backwards keeps swap-removal from skipping entries
+    for (int32 i = Characters.Num() - 1; i >= 0; i--)
+    {
+        if (!Characters[i].IsValid())
+        {
+            RemoveSlot(i);
+        }
+    }
+
+    bHasStaleSlots = false;
+}
@@ -0,0 +1,76 @@
+// AIBuilderTimingWheelSubsystem.cpp - Timing wheel implementation
+#include "Subsystems/AIBuilderTimingWheelSubsystem.h"
+#include "Components/AIBuilderStateMachine.h"
+#include "Engine/World.h"
+#include "AIBuilder.h"
+
+UAIBuilderTimingWheelSubsystem::UAIBuilderTimingWheelSubsystem()
+{
+    CurrentSlot = 0;
+    Accumulator = 0.0f;
+}
+
+bool UAIBuilderTimingWheelSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAIBuilderTimingWheelSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+    Slots.SetNum(NumSlots);
+}
+
+TStatId UAIBuilderTimingWheelSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UAIBuilderTimingWheelSubsystem, STATGROUP_Tickables);
+}
+
+void UAIBuilderTimingWheelSubsystem::Schedule(UAIBuilderStateMachine* StateMachine, uint32 Token, float Delay)
+{
+    // Part of the current slot has already passed, count it so the timer never fires early
+    const int32 Ticks = FMath::Max(1, FMath::CeilToInt32((FMath::Max(Delay, 0.0f) + Accumulator) / SlotDuration));
+
+    FTimer& Timer = Slots[(CurrentSlot + Ticks) % NumSlots].AddDefaulted_GetRef();
+    Timer.StateMachine = StateMachine;
+    Timer.Token = Token;
+    Timer.Laps = static_cast<uint32>((Ticks - 1) / NumSlots);
+}
+
+void UAIBuilderTimingWheelSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    Accumulator += DeltaTime;
+
+    while (Accumulator >= SlotDuration)
+    {
+        Accumulator -= SlotDuration;
+        CurrentSlot = (CurrentSlot + 1) % NumSlots;
+
+        TArray<FTimer>& Slot = Slots[CurrentSlot];
+        for (int32 i = Slot.Num() - 1; i >= 0; i--)
+        {
+            FTimer& Timer = Slot[i];
+            if (Timer.Laps > 0)
+            {
+                Timer.Laps--;
+                continue;
+            }
+
+            DueTimers.Add(Timer);
+            Slot.RemoveAtSwap(i, 1, EAllowShrinking::No);
+        }
+    }
+
+    // Callbacks schedule their next wake-up, so they only run once the slots are settled
+    for (const FTimer& Timer : DueTimers)
+    {
+        if (UAIBuilderStateMachine* StateMachine = Timer.StateMachine.Get())
+        {
+            StateMachine->OnTimingWheelFired(Timer.Token);
+        }
+    }
+
+    DueTimers.Reset();
+}
@@ -0,0 +1,396 @@
+// AIBuilderPerformanceTest.cpp - Headless performance tests for sensors, state machines and code generation
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Core/AIBuilderCharacter.h"
+#include "Components/AIBuilderSensorComponent.h"
+#include "Components/AIBuilderStateMachine.h"
+#include "Subsystems/AIBuilderSensorSchedulerSubsystem.h"
+#include "Subsystems/AIBuilderTickManagerSubsystem.h"
+#include "AICodeGenerator.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "AIBuilder.h"
+
+namespace AIBuilderPerformanceTest
+{
+    constexpr float FrameDeltaTime = 1.0f / 60.0f;
+    constexpr int32 WarmupFrames = 30;
+    constexpr int32 MeasuredFrames = 300;
+
+    // All densities share one square area, so more agents means more neighbours per sensor
+    constexpr float AreaSize = 10000.0f;
+
+    // Matches the fixed 0.1 s AI update of AAIBuilderCharacter at 60 fps
+    constexpr int32 StateMachineFrameInterval = 6;
+
+    struct FRunResult
+    {
+        int32 NumAgents = 0;
+        bool bParallel = false;
+        double FrameMs = 0.0;
+        double SensorGatherMs = 0.0;
+        double SensorEvaluateMs = 0.0;
+        double SensorApplyMs = 0.0;
+        double StateMachineMs = 0.0;
+        double SensorsUpdatedPerFrame = 0.0;
+        double DetectionsPerAgent = 0.0;
+        int64 MemoryDeltaBytes = 0;
+    };
+
+    UWorld* CreateTestWorld()
+    {
+        UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("AIBuilderPerformanceWorld"));
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(World);
+
+        World->InitializeActorsForPlay(FURL());
+        World->BeginPlay();
+        return World;
+    }
+
+    void DestroyTestWorld(UWorld* World)
+    {
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+    }
+
+    TArray<AAIBuilderCharacter*> SpawnAgents(UWorld* World, int32 NumAgents)
+    {
+        TArray<AAIBuilderCharacter*> Agents;
+        FRandomStream Random(NumAgents);
+
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+        for (int32 i = 0; i < NumAgents; i++)
+        {
+            const FVector Location(Random.FRandRange(0.0f, AreaSize), Random.FRandRange(0.0f, AreaSize), 100.0f);
+            const FRotator Rotation(0.0f, Random.FRandRange(0.0f, 360.0f), 0.0f);
+
+            if (AAIBuilderCharacter* Agent = World->SpawnActor<AAIBuilderCharacter>(Location, Rotation, SpawnParams))
+            {
+                // Keep movement out of the measurement, there is no floor to stand on anyway
+                Agent->GetCharacterMovement()->SetComponentTickEnabled(false);
+
+                // The state machine is driven and timed by the test instead
+                Agent->SetActorTickEnabled(false);
+                if (UAIBuilderTickManagerSubsystem* TickManager = World->GetSubsystem<UAIBuilderTickManagerSubsystem>())
+                {
+                    TickManager->UnregisterCharacter(Agent);
+                }
+                Agents.Add(Agent);
+            }
+        }
+
+        return Agents;
+    }
+
+    FRunResult RunScenario(int32 NumAgents, bool bParallel)
+    {
+        FRunResult Result;
+        Result.NumAgents = NumAgents;
+        Result.bParallel = bParallel;
+
+        UWorld* World = CreateTestWorld();
+        UAIBuilderSensorSchedulerSubsystem* Scheduler = World->GetSubsystem<UAIBuilderSensorSchedulerSubsystem>();
+        if (Scheduler)
+        {
+            Scheduler->bParallelSensorEvaluation = bParallel;
+
+            // Measure the full cost, not what fits into the default budget
+            Scheduler->FrameBudgetMs = 1000.0f;
+        }
+
+        const uint64 MemoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+        TArray<AAIBuilderCharacter*> Agents = SpawnAgents(World, NumAgents);
+
+        for (int32 Frame = 0; Frame < WarmupFrames + MeasuredFrames; Frame++)
+        {
+            const bool bMeasure = Frame >= WarmupFrames;
+
+            const double FrameStart = FPlatformTime::Seconds();
+            World->Tick(LEVELTICK_All, FrameDeltaTime);
+            const double FrameEnd = FPlatformTime::Seconds();
+
+            double StateMachineSeconds = 0.0;
+            if (Frame % StateMachineFrameInterval == 0)
+            {
+                const double StateStart = FPlatformTime::Seconds();
+                for (AAIBuilderCharacter* Agent : Agents)
+                {
+                    Agent->GetStateMachine()->UpdateState(FrameDeltaTime * StateMachineFrameInterval);
+                }
+                StateMachineSeconds = FPlatformTime::Seconds() - StateStart;
+            }
+
+            if (!bMeasure)
+            {
+                continue;
+            }
+
+            Result.FrameMs += (FrameEnd - FrameStart) * 1000.0;
+            Result.StateMachineMs += StateMachineSeconds * 1000.0;
+
+            if (Scheduler)
+            {
+                const FAISensorSchedulerFrameStats& Stats = Scheduler->GetLastFrameStats();
+                Result.SensorGatherMs += Stats.GatherMs;
+                Result.SensorEvaluateMs += Stats.EvaluateMs;
+                Result.SensorApplyMs += Stats.ApplyMs;
+                Result.SensorsUpdatedPerFrame += Stats.SensorsUpdated;
+            }
+        }
+
+        Result.MemoryDeltaBytes = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - static_cast<int64>(MemoryBefore);
+
+        int32 TotalDetections = 0;
+        for (AAIBuilderCharacter* Agent : Agents)
+        {
+            TotalDetections += Agent->GetSensorComponent()->GetDetectionsView().Num();
+        }
+
+        Result.FrameMs /= MeasuredFrames;
+        Result.SensorGatherMs /= MeasuredFrames;
+        Result.SensorEvaluateMs /= MeasuredFrames;
+        Result.SensorApplyMs /= MeasuredFrames;
+        Result.StateMachineMs /= MeasuredFrames;
+        Result.SensorsUpdatedPerFrame /= MeasuredFrames;
+        Result.DetectionsPerAgent = Agents.Num() > 0 ? static_cast<double>(TotalDetections) / Agents.Num() : 0.0;
+
+        DestroyTestWorld(World);
+        return Result;
+    }
+
+    FString WriteResultJson(const FRunResult& Result)
+    {
+        FString Json;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("test"), TEXT("AIBuilder.Performance.Agents"));
+        Writer->WriteValue(TEXT("agents"), Result.NumAgents);
+        Writer->WriteValue(TEXT("parallel"), Result.bParallel);
+        Writer->WriteValue(TEXT("frames"), MeasuredFrames);
+        Writer->WriteValue(TEXT("frame_ms"), Result.FrameMs);
+        Writer->WriteValue(TEXT("sensor_gather_ms"), Result.SensorGatherMs);
+        Writer->WriteValue(TEXT("sensor_evaluate_ms"), Result.SensorEvaluateMs);
+        Writer->WriteValue(TEXT("sensor_apply_ms"), Result.SensorApplyMs);
+        Writer->WriteValue(TEXT("state_machine_ms"), Result.StateMachineMs);
+        Writer->WriteValue(TEXT("sensors_updated_per_frame"), Result.SensorsUpdatedPerFrame);
+        Writer->WriteValue(TEXT("detections_per_agent"), Result.DetectionsPerAgent);
+        Writer->WriteValue(TEXT("memory_delta_bytes"), Result.MemoryDeltaBytes);
+        Writer->WriteObjectEnd();
+        Writer->Close();
+
+        const FString FileName = FString::Printf(TEXT("Agents_%d_%s.json"), Result.NumAgents, Result.bParallel ? TEXT("Parallel") : TEXT("Serial"));
+        const FString FilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Automation"), TEXT("AIBuilderPerformance"), FileName);
+        FFileHelper::SaveStringToFile(Json, *FilePath);
+        return FilePath;
+    }
+
+    // Best of several runs, the first run also warms up the task graph workers
+    constexpr int32 CodeGenRuns = 3;
+
+    const TCHAR* CodeGenNames[] = { TEXT("Guard"), TEXT("Sentry"), TEXT("Hunter"), TEXT("Scout") };
+
+    // Even requests ask for characters, odd ones for behavior tree tasks
+    TArray<FString> MakeCodeGenRequests(int32 NumRequests)
+    {
+        const TCHAR* Kinds[] = { TEXT("character that patrols and chases intruders"), TEXT("behavior tree task that searches for cover") };
+
+        TArray<FString> Requests;
+        for (int32 i = 0; i < NumRequests; i++)
+        {
+            Requests.Add(FString::Printf(TEXT("Create a %s%d %s"), CodeGenNames[i % UE_ARRAY_COUNT(CodeGenNames)], i, Kinds[i % UE_ARRAY_COUNT(Kinds)]));
+        }
+        return Requests;
+    }
+
+    FString GetExpectedCodeGenClassName(int32 RequestIndex)
+    {
+        // CapitalizeFirstLetter lowers the rest of the name
+        const FString Name = FString::Printf(TEXT("%s%d"), CodeGenNames[RequestIndex % UE_ARRAY_COUNT(CodeGenNames)], RequestIndex);
+        const FString ClassName = Name.Left(1).ToUpper() + Name.Mid(1).ToLower();
+        return RequestIndex % 2 != 0 ? TEXT("BTTask_") + ClassName : ClassName + TEXT("Character");
+    }
+
+    double TimeCodeGenBatch(UAICodeGenerator* Generator, const TArray<FString>& Requests, bool bParallel, TArray<FGeneratedCode>& OutResults)
+    {
+        double BestMs = TNumericLimits<double>::Max();
+        for (int32 Run = 0; Run < CodeGenRuns; Run++)
+        {
+            const double StartTime = FPlatformTime::Seconds();
+            OutResults = Generator->GenerateBatch(Requests, bParallel);
+            BestMs = FMath::Min(BestMs, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+        }
+        return BestMs;
+    }
+}
+
+// Run headless with:
+//   UnrealEditor-Cmd <Project> -ExecCmds="Automation RunTests AIBuilder.Performance; Quit" -nullrhi -unattended
+// Results are written as one JSON file per scenario under Saved/Automation/AIBuilderPerformance.
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FAIBuilderAgentPerformanceTest, "AIBuilder.Performance.Agents",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::PerfFilter)
+
+void FAIBuilderAgentPerformanceTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    const int32 AgentCounts[] = { 50, 150, 300, 600 };
+
+    for (int32 NumAgents : AgentCounts)
+    {
+        for (bool bParallel : { false, true })
+        {
+            OutBeautifiedNames.Add(FString::Printf(TEXT("%d Agents %s"), NumAgents, bParallel ? TEXT("Parallel") : TEXT("Serial")));
+            OutTestCommands.Add(FString::Printf(TEXT("Agents=%d Parallel=%d"), NumAgents, bParallel ? 1 : 0));
+        }
+    }
+}
+
+bool FAIBuilderAgentPerformanceTest::RunTest(const FString& Parameters)
+{
+    using namespace AIBuilderPerformanceTest;
+
+    int32 NumAgents = 0;
+    int32 Parallel = 0;
+    FParse::Value(*Parameters, TEXT("Agents="), NumAgents);
+    FParse::Value(*Parameters, TEXT("Parallel="), Parallel);
+
+    if (!TestTrue(TEXT("Agent count is positive"), NumAgents > 0))
+    {
+        return false;
+    }
+
+    const FRunResult Result = RunScenario(NumAgents, Parallel != 0);
+    const FString FilePath = WriteResultJson(Result);
+
+    AddInfo(FString::Printf(TEXT("%d agents (%s): frame %.3f ms, sensors %.3f/%.3f/%.3f ms gather/evaluate/apply, state machines %.3f ms, %.1f detections per agent"),
+        Result.NumAgents,
+        Result.bParallel ? TEXT("parallel") : TEXT("serial"),
+        Result.FrameMs,
+        Result.SensorGatherMs,
+        Result.SensorEvaluateMs,
+        Result.SensorApplyMs,
+        Result.StateMachineMs,
+        Result.DetectionsPerAgent));
+    AddInfo(FString::Printf(TEXT("Results written to %s"), *FilePath));
+
+    TestTrue(TEXT("Sensors were updated"), Result.SensorsUpdatedPerFrame > 0.0);
+    return true;
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FAIBuilderCodeGenPerformanceTest, "AIBuilder.Performance.CodeGen",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::PerfFilter)
+
+void FAIBuilderCodeGenPerformanceTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    const int32 RequestCounts[] = { 50, 200, 800 };
+
+    for (int32 NumRequests : RequestCounts)
+    {
+        OutBeautifiedNames.Add(FString::Printf(TEXT("%d Requests"), NumRequests));
+        OutTestCommands.Add(FString::Printf(TEXT("Requests=%d"), NumRequests));
+    }
+}
+
+bool FAIBuilderCodeGenPerformanceTest::RunTest(const FString& Parameters)
+{
+    using namespace AIBuilderPerformanceTest;
+
+    int32 NumRequests = 0;
+    FParse::Value(*Parameters, TEXT("Requests="), NumRequests);
+
+    if (!TestTrue(TEXT("Request count is positive"), NumRequests > 0))
+    {
+        return false;
+    }
+
+    // Measure generation itself, not cache lookups
+    UAICodeGenerator* Generator = NewObject<UAICodeGenerator>();
+    Generator->bUseGenerationCache = false;
+
+    const FGeneratedCode Character = Generator->GenerateCodeFromRequest(TEXT("Create a guard character that patrols"));
+    TestTrue(TEXT("Character request succeeds"), Character.bSuccess);
+    TestEqual(TEXT("Character class name"), Character.FileName, FString(TEXT("GuardCharacter")));
+
+    // The request is pasted into a TEXT() literal of the task source
+    const FGeneratedCode Quoted = Generator->GenerateCodeFromRequest(TEXT("Create a behavior tree task that says \"hold\" at C:\\Cover"));
+    TestTrue(TEXT("Quotes and backslashes are escaped in string literals"), Quoted.SourceCode.Contains(TEXT("says \\\"hold\\\" at C:\\\\Cover")));
+    const TArray<FString> Requests = MakeCodeGenRequests(NumRequests);
+
+    TArray<FGeneratedCode> SerialResults;
+    TArray<FGeneratedCode> ParallelResults;
+    const double SerialMs = TimeCodeGenBatch(Generator, Requests, false, SerialResults);
+    const double ParallelMs = TimeCodeGenBatch(Generator, Requests, true, ParallelResults);
+    const double Speedup = ParallelMs > 0.0 ? SerialMs / ParallelMs : 0.0;
+
+    FString Json;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("test"), TEXT("AIBuilder.Performance.CodeGen"));
+    Writer->WriteValue(TEXT("requests"), NumRequests);
+    Writer->WriteValue(TEXT("serial_ms"), SerialMs);
+    Writer->WriteValue(TEXT("parallel_ms"), ParallelMs);
+    Writer->WriteValue(TEXT("speedup"), Speedup);
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    const FString FilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Automation"), TEXT("AIBuilderPerformance"),
+                                             FString::Printf(TEXT("CodeGen_%d.json"), NumRequests));
+    FFileHelper::SaveStringToFile(Json, *FilePath);
+
+    AddInfo(FString::Printf(TEXT("%d requests: serial %.2f ms, parallel %.2f ms, %.2fx speedup"), NumRequests, SerialMs, ParallelMs, Speedup));
+    AddInfo(FString::Printf(TEXT("Results written to %s"), *FilePath));
+
+    if (TestEqual(TEXT("Serial result count"), SerialResults.Num(), NumRequests))
+    {
+        // Every request names its class, so saving the batch writes one file pair per request
+        TSet<FString> FileNames;
+        for (const FGeneratedCode& Result : SerialResults)
+        {
+            FileNames.Add(Result.FileName);
+        }
+        TestEqual(TEXT("Distinct file names"), FileNames.Num(), SerialResults.Num());
+
+        for (int32 i = 0; i < SerialResults.Num(); i++)
+        {
+            const FString ExpectedClassName = GetExpectedCodeGenClassName(i);
+            if (!SerialResults[i].bSuccess || SerialResults[i].FileName != ExpectedClassName)
+            {
+                AddError(FString::Printf(TEXT("Request %d produced '%s' (%s), expected '%s'"), i, *SerialResults[i].FileName,
+                                         SerialResults[i].bSuccess ? TEXT("succeeded") : *SerialResults[i].ErrorMessage, *ExpectedClassName));
+                break;
+            }
+        }
+    }
+
+    // The parallel batch must produce exactly what the serial path does, in the same order
+    if (TestEqual(TEXT("Result count"), ParallelResults.Num(), SerialResults.Num()))
+    {
+        for (int32 i = 0; i < SerialResults.Num(); i++)
+        {
+            if (ParallelResults[i].bSuccess != SerialResults[i].bSuccess
+                || ParallelResults[i].FileName != SerialResults[i].FileName
+                || ParallelResults[i].HeaderCode != SerialResults[i].HeaderCode
+                || ParallelResults[i].SourceCode != SerialResults[i].SourceCode)
+            {
+                AddError(FString::Printf(TEXT("Parallel result %d differs from the serial one"), i));
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
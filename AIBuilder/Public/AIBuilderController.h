@@ -6,6 +6,7 @@
 #include "Perception/AIPerceptionComponent.h"
 #include "BehaviorTree/BehaviorTreeComponent.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "Core/AIBuilderBlackboardKeys.h"
 #include "AIBuilderController.generated.h"
 
 UCLASS()
@@ -49,6 +50,10 @@ protected:
     virtual void SetupPerceptionSystem();
     virtual void ConfigureBlackboard();
 
+    // The possessed character uses unified perception, so our perception component stays idle
+    bool UsesUnifiedPerception() const;
+    void DisablePerceptionSystem();
+
     UFUNCTION()
     virtual void OnPerceptionUpdated(const TArray<AActor*>& UpdatedActors);
 
@@ -56,6 +61,8 @@ private:
     bool bAIStarted;
     bool bAIPaused;
 
+    FAIBuilderBlackboardKeys BlackboardKeys;
+
     void InitializeComponents();
     void LogAIStatus(const FString& Status) const;
 };
\ No newline at end of file
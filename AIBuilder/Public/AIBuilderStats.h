@@ -0,0 +1,46 @@
+// AIBuilderStats.h - Stat group, counters and trace channel for profiling
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_STATS_GROUP(TEXT("AIBuilder"), STATGROUP_AIBuilder, STATCAT_Advanced);
+
+// Sensors
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Sensor Scheduler"), STAT_AIBuilder_SensorScheduler, STATGROUP_AIBuilder, AIBUILDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Sight Candidates"), STAT_AIBuilder_SightCandidates, STATGROUP_AIBuilder, AIBUILDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Sight Cone"), STAT_AIBuilder_SightCone, STATGROUP_AIBuilder, AIBUILDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Sight Traces"), STAT_AIBuilder_SightTraces, STATGROUP_AIBuilder, AIBUILDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Sight Trace Results"), STAT_AIBuilder_SightTraceResults, STATGROUP_AIBuilder, AIBUILDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hearing"), STAT_AIBuilder_Hearing, STATGROUP_AIBuilder, AIBUILDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Touch"), STAT_AIBuilder_Touch, STATGROUP_AIBuilder, AIBUILDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Detection Table"), STAT_AIBuilder_DetectionTable, STATGROUP_AIBuilder, AIBUILDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spatial Grid Rebuild"), STAT_AIBuilder_SpatialGridRebuild, STATGROUP_AIBuilder, AIBUILDER_API);
+
+// State machines
+DECLARE_CYCLE_STAT_EXTERN(TEXT("State Update"), STAT_AIBuilder_StateUpdate, STATGROUP_AIBuilder, AIBUILDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AI Tick Manager"), STAT_AIBuilder_TickManager, STATGROUP_AIBuilder, AIBUILDER_API);
+
+// Code generation
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CodeGen Parse"), STAT_AIBuilder_CodeGenParse, STATGROUP_AIBuilder, AIBUILDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CodeGen Templates"), STAT_AIBuilder_CodeGenTemplates, STATGROUP_AIBuilder, AIBUILDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CodeGen Validate"), STAT_AIBuilder_CodeGenValidate, STATGROUP_AIBuilder, AIBUILDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CodeGen Save"), STAT_AIBuilder_CodeGenSave, STATGROUP_AIBuilder, AIBUILDER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CodeGen Batch"), STAT_AIBuilder_CodeGenBatch, STATGROUP_AIBuilder, AIBUILDER_API);
+
+// Counters. Active detections is a running total, the others are cleared every frame.
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Detections"), STAT_AIBuilder_ActiveDetections, STATGROUP_AIBuilder, AIBUILDER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Sight Traces Issued"), STAT_AIBuilder_SightTracesIssued, STATGROUP_AIBuilder, AIBUILDER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Sensors Updated"), STAT_AIBuilder_SensorsUpdated, STATGROUP_AIBuilder, AIBUILDER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Noise Events"), STAT_AIBuilder_NoiseEvents, STATGROUP_AIBuilder, AIBUILDER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("State Transitions"), STAT_AIBuilder_StateTransitions, STATGROUP_AIBuilder, AIBUILDER_API);
+
+// Enable with -trace=cpu,aibuilder to see only AI Builder scopes in Insights
+UE_TRACE_CHANNEL_EXTERN(AIBuilderChannel, AIBUILDER_API);
+
+// Times a scope for both stat AIBuilder and the AIBuilder trace channel
+#define AIBUILDER_SCOPE_CYCLE_COUNTER(Stat) \
+    SCOPE_CYCLE_COUNTER(Stat); \
+    TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(#Stat, AIBuilderChannel)
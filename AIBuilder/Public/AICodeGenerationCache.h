@@ -0,0 +1,47 @@
+// AICodeGenerationCache.h - Content addressed cache of generated code
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AICodeGenerator.h"
+
+// Generated code keyed by a hash of the template version and the normalized request, shared
+// by every code generator in the process and persisted to Saved/AIBuilder/CodeGenCache.bin.
+// All functions may be called from any thread.
+class AIBUILDER_API FAICodeGenerationCache
+{
+public:
+    // The cache is cleared when it grows past this, rather than tracking usage per entry
+    static constexpr int32 MaxEntries = 4096;
+
+    // Loads the persisted cache on first use
+    static FAICodeGenerationCache& Get();
+
+    // Trims the request and collapses whitespace runs to one space
+    static FString NormalizeRequest(FStringView Request);
+
+    // Kind tells apart the generator entry points that take the same strings
+    static uint64 MakeKey(uint64 TemplateVersion, FStringView Kind, FStringView Request, FStringView Extra = FStringView());
+
+    bool Find(uint64 Key, FGeneratedCode& OutCode) const;
+    void Add(uint64 Key, const FGeneratedCode& Code);
+    int32 Num() const;
+
+    // Writes the cache file if entries were added since it was loaded or last saved
+    bool SaveIfDirty();
+
+    // Leaves the file alone when it already holds Content, so its timestamp doesn't trigger a rebuild.
+    // False only when a write was needed and failed.
+    static bool WriteFileIfChanged(const FString& Filename, const FString& Content, bool& bOutWritten);
+
+    static FString GetCacheFilename();
+
+private:
+    FAICodeGenerationCache();
+
+    bool Serialize(FArchive& Ar);
+
+    mutable FRWLock Lock;
+    FCriticalSection SaveLock;
+    TMap<uint64, FGeneratedCode> Entries;
+    bool bDirty;
+};
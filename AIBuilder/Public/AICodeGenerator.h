@@ -4,6 +4,9 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "Engine/Engine.h"
+#include "Tasks/Pipe.h"
+#include "AICodeTemplate.h"
+#include "AIKeywordMatcher.h"
 #include "AICodeGenerator.generated.h"
 
 USTRUCT(BlueprintType)
@@ -67,6 +70,38 @@ struct FGeneratedCode
     }
 };
 
+// Everything the keyword vocabulary recognizes in a request, found in a single scan
+USTRUCT(BlueprintType)
+struct FCodeRequestScan
+{
+    GENERATED_BODY()
+
+    // Every vocabulary word found in the request, lower case, in the order their first matches end
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FString> Keywords;
+
+    // Highest priority class type word, such as "character". Empty without one.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FString ClassType;
+
+    // Position of the first occurrence of ClassType in the request
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 ClassTypeIndex;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FString BaseClass;
+
+    // Behaviors of the matched AI keywords, such as "PatrolBehavior"
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FString> Features;
+
+    FCodeRequestScan()
+    {
+        ClassTypeIndex = INDEX_NONE;
+        BaseClass = TEXT("UObject");
+    }
+};
+
 UCLASS(BlueprintType, Blueprintable)
 class AIBUILDER_API UAICodeGenerator : public UObject
 {
@@ -75,10 +110,17 @@ class AIBUILDER_API UAICodeGenerator : public UObject
 public:
     UAICodeGenerator();
 
+    virtual void BeginDestroy() override;
+
     // Main AI Code Generation Function
     UFUNCTION(BlueprintCallable, Category = "AI Code Generator")
     FGeneratedCode GenerateCodeFromRequest(const FString& UserRequest);
 
+    // Generates every request in parallel and returns the results in request order. Requests only
+    // read the templates compiled at Initialize, which must not run while a batch is in flight.
+    UFUNCTION(BlueprintCallable, Category = "AI Code Generator")
+    TArray<FGeneratedCode> GenerateBatch(const TArray<FString>& UserRequests, bool bParallel = true);
+
     // Specific Code Generation Functions
     UFUNCTION(BlueprintCallable, Category = "AI Code Generator")
     FGeneratedCode CreateAICharacter(const FString& CharacterName, const FString& BehaviorDescription);
@@ -93,21 +135,40 @@ public:
     FGeneratedCode CreateAIComponent(const FString& ComponentName, const FString& ComponentPurpose);
 
     // Utility Functions
+    // Queues the files on a background writer and returns; files are written in call order
     UFUNCTION(BlueprintCallable, Category = "AI Code Generator")
     void SaveGeneratedCode(const FGeneratedCode& Code, const FString& OutputPath);
 
+    // Same, OnSaved runs on the game thread once the files are written, or right away when Code failed
+    void SaveGeneratedCode(const FGeneratedCode& Code, const FString& OutputPath, TFunction<void(bool bSaved)> OnSaved);
+
+    // Blocks until every queued SaveGeneratedCode call has written its files
+    UFUNCTION(BlueprintCallable, Category = "AI Code Generator")
+    void FlushPendingSaves();
+
     UFUNCTION(BlueprintCallable, Category = "AI Code Generator")
     TArray<FString> GetAvailableTemplates() const;
 
     UFUNCTION(BlueprintCallable, Category = "AI Code Generator")
     void Initialize();
 
+    // Matches the request against AIKeywords and ClassTypePatterns in one pass
+    UFUNCTION(BlueprintCallable, Category = "AI Code Generator")
+    FCodeRequestScan ScanRequest(const FString& Request) const;
+
+    // Return results of identical earlier requests from FAICodeGenerationCache instead of regenerating
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Code Generator")
+    bool bUseGenerationCache = true;
+
 protected:
+    // Parses and renders a normalized request, bypassing the cache
+    FGeneratedCode RenderRequest(const FString& UserRequest);
+
     // Natural Language Processing
     FCodeRequest ParseUserRequest(const FString& UserRequest);
-    FString ExtractClassName(const FString& Request);
-    FString DetermineBaseClass(const FString& Request);
-    TArray<FString> ExtractRequiredFeatures(const FString& Request);
+    FString ExtractClassName(const FString& Request, const FCodeRequestScan& Scan);
+    FString DetermineBaseClass(const FCodeRequestScan& Scan);
+    TArray<FString> ExtractRequiredFeatures(const FCodeRequestScan& Scan);
 
     // Code Generation Templates
     FString GenerateHeaderTemplate(const FCodeRequest& Request);
@@ -135,17 +196,48 @@ private:
     TMap<FString, FString> SourceTemplates;
     TMap<FString, FString> CodeSnippets;
 
+    // Header and source templates compiled at Initialize, same keys as above
+    TMap<FString, FAICodeTemplate> CompiledHeaderTemplates;
+    TMap<FString, FAICodeTemplate> CompiledSourceTemplates;
+
+    // Hash of every template and the generator version, part of each cache key
+    uint64 TemplateVersion = 0;
+
     // AI Keywords and Patterns
     TMap<FString, FString> AIKeywords;
-    TMap<FString, FString> ClassTypePatterns;
+    // Keyword and base class, in priority order
+    TArray<TPair<FString, FString>> ClassTypePatterns;
     TMap<FString, TArray<FString>> RequiredIncludesMap;
 
+    // What a matcher pattern stands for, indexed by pattern
+    struct FKeywordInfo
+    {
+        FString Keyword;
+        FString Feature;
+        FString BaseClass;
+
+        // Index in ClassTypePatterns, lower wins
+        int32 ClassTypePriority = INDEX_NONE;
+    };
+
+    // Built from AIKeywords and ClassTypePatterns at Initialize
+    FAIKeywordMatcher KeywordMatcher;
+    TArray<FKeywordInfo> KeywordInfos;
+
+    // Serializes file writes off the calling thread
+    UE::Tasks::FPipe SavePipe{ TEXT("AICodeGeneratorSave") };
+
     void InitializeTemplates();
     void InitializeAIKeywords();
     void InitializeCodeSnippets();
+    void BuildKeywordMatcher();
 
     // Helper Functions
     FString ReplaceTemplateVariables(const FString& Template, const FCodeRequest& Request);
+    // The args view OutDescriptionLiteral, which must outlive them
+    FAICodeTemplateArgs MakeTemplateArgs(const FCodeRequest& Request, FString& OutDescriptionLiteral) const;
+    FGeneratedCode RenderTemplates(const FString& TemplateKey, const FAICodeTemplateArgs& Args, const FString& FileName) const;
+    const TCHAR* FindTemplateKey(const FString& BaseClass) const;
     bool ContainsKeyword(const FString& Text, const FString& Keyword);
     FString CapitalizeFirstLetter(const FString& Input);
     FString GenerateUniqueClassName(const FString& BaseName);
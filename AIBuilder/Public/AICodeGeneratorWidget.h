@@ -8,8 +8,12 @@
 #include "Components/TextBlock.h"
 #include "Components/MultiLineEditableTextBox.h"
 #include "AICodeGenerator.h"
+#include "Tasks/Task.h"
 #include "AICodeGeneratorWidget.generated.h"
 
+// State shared between the widget and its background generation task
+struct FAICodeGenerationJob;
+
 UCLASS(BlueprintType, Blueprintable)
 class AIBUILDER_API UAICodeGeneratorWidget : public UUserWidget
 {
@@ -20,6 +24,9 @@ public:
 
 protected:
     virtual void NativeConstruct() override;
+    virtual void NativeDestruct() override;
+    virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+    virtual void BeginDestroy() override;
 
     // UI Components
     UPROPERTY(meta = (BindWidget))
@@ -40,6 +47,13 @@ protected:
     UPROPERTY(meta = (BindWidget))
     class UMultiLineEditableTextBox* SourceCodeBox;
 
+    UPROPERTY(meta = (BindWidgetOptional))
+    class UButton* CancelButton;
+
+    // Shown while code is generated in the background
+    UPROPERTY(meta = (BindWidgetOptional))
+    class UProgressBar* GenerationProgressBar;
+
     // AI Code Generator Reference
     UPROPERTY()
     class UAICodeGenerator* CodeGenerator;
@@ -50,9 +64,16 @@ protected:
 
 public:
     // Blueprint callable functions
+    // Starts generating in the background, replacing a generation that is still running
     UFUNCTION(BlueprintCallable, Category = "AI Code Generator")
     void GenerateCodeFromInput();
 
+    UFUNCTION(BlueprintCallable, Category = "AI Code Generator")
+    void CancelGeneration();
+
+    UFUNCTION(BlueprintPure, Category = "AI Code Generator")
+    bool IsGenerating() const;
+
     UFUNCTION(BlueprintCallable, Category = "AI Code Generator")
     void SaveGeneratedCode();
 
@@ -70,10 +91,34 @@ protected:
     UFUNCTION()
     void OnSaveButtonClicked();
 
+    UFUNCTION()
+    void OnCancelButtonClicked();
+
+    // Edits in a code box mean it no longer holds the displayed copy
+    UFUNCTION()
+    void OnHeaderCodeChanged(const FText& Text);
+
+    UFUNCTION()
+    void OnSourceCodeChanged(const FText& Text);
+
+    // Runs on the game thread with the result of the active job
+    void OnGenerationFinished(FGeneratedCode&& Code);
+
     void UpdateUI();
     void ShowStatus(const FString& Message, bool bIsError = false);
 
 private:
     void InitializeCodeGenerator();
     FString GetDefaultSavePath() const;
+
+    // Large generated files are slow to lay out, so text boxes are only touched when their text changes
+    void SetCodeBoxText(class UMultiLineEditableTextBox* CodeBox, const FString& Code, FString& DisplayedCode);
+    void SetProgressVisible(bool bVisible);
+
+    TSharedPtr<FAICodeGenerationJob> ActiveJob;
+    UE::Tasks::FTask GenerationTask;
+    float DisplayedProgress;
+
+    FString DisplayedHeaderCode;
+    FString DisplayedSourceCode;
 };
\ No newline at end of file
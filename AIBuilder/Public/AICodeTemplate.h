@@ -0,0 +1,56 @@
+// AICodeTemplate.h - Precompiled code templates with named placeholders
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Values bound to template variables for one render, looked up by name
+struct AIBUILDER_API FAICodeTemplateArgs
+{
+    FAICodeTemplateArgs& Add(FName Name, FStringView Value)
+    {
+        Values.Emplace(Name, Value);
+        return *this;
+    }
+
+    const FStringView* Find(FName Name) const;
+
+private:
+    TArray<TPair<FName, FStringView>, TInlineAllocator<8>> Values;
+};
+
+// A template parsed once into literal runs and variable slots. Placeholders are written
+// {{Name}}; braces that don't enclose an identifier, such as C++ initializer lists, stay
+// literal. A compiled template is immutable, so any thread may render it.
+class AIBUILDER_API FAICodeTemplate
+{
+public:
+    FAICodeTemplate() = default;
+    explicit FAICodeTemplate(FStringView Source) { Compile(Source); }
+
+    void Compile(FStringView Source);
+
+    // Appends the template to Builder in a single pass. Unbound variables render empty.
+    void Render(const FAICodeTemplateArgs& Args, FStringBuilderBase& Builder) const;
+    FString Render(const FAICodeTemplateArgs& Args) const;
+
+    const TArray<FName>& GetVariables() const { return Variables; }
+    bool IsEmpty() const { return Segments.Num() == 0; }
+
+private:
+    // A literal run of Literals, or a variable slot when VariableIndex is set
+    struct FSegment
+    {
+        int32 Start = 0;
+        int32 Len = 0;
+        int32 VariableIndex = INDEX_NONE;
+    };
+
+    // Every literal run, back to back
+    FString Literals;
+    TArray<FSegment> Segments;
+
+    // Distinct variable names, referenced by FSegment::VariableIndex
+    TArray<FName> Variables;
+
+    void AddLiteral(FStringView Text);
+};
@@ -0,0 +1,59 @@
+// AIKeywordMatcher.h - Multi-keyword matcher for code generation requests
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAIKeywordMatch
+{
+    int32 PatternIndex = INDEX_NONE;
+
+    // Position in the scanned text
+    int32 Start = 0;
+    int32 Len = 0;
+};
+
+// Aho-Corasick automaton over a small case folded alphabet: letters, digits, whitespace and one
+// symbol for everything else. Finds every occurrence of every pattern in one pass over the text,
+// however many patterns there are. Immutable after Build, so any thread may scan.
+class AIBUILDER_API FAIKeywordMatcher
+{
+public:
+    FAIKeywordMatcher();
+
+    void Reset();
+
+    // Case insensitive. Adding a pattern twice returns the index it already has.
+    int32 AddPattern(FStringView Pattern);
+
+    // Turns the pattern trie into the automaton. Required after adding patterns.
+    void Build();
+
+    // Appends the matches ordered by where they end, substrings like Contains would find
+    void Scan(FStringView Text, TArray<FAIKeywordMatch>& OutMatches) const;
+
+    int32 NumPatterns() const { return PatternLengths.Num(); }
+
+private:
+    // a-z, 0-9, whitespace, anything else
+    static constexpr int32 NumSymbols = 38;
+
+    static int32 GetSymbol(TCHAR Char);
+
+    struct FNode
+    {
+        // Child in the trie, every symbol has a transition once built
+        int32 Next[NumSymbols];
+
+        // Pattern ending at this node
+        int32 Pattern = INDEX_NONE;
+
+        // Nearest node on the failure chain that ends a pattern
+        int32 OutputLink = INDEX_NONE;
+    };
+
+    TArray<FNode> Nodes;
+    TArray<int32> PatternLengths;
+    bool bBuilt;
+
+    int32 AddNode();
+};
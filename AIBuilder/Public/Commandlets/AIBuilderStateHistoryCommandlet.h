@@ -0,0 +1,21 @@
+// AIBuilderStateHistoryCommandlet.h - Offline replay of state history dumps
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AIBuilderStateHistoryCommandlet.generated.h"
+
+// Rebuilds agent timelines from an AIBuilder.DumpStateHistory file and reports flapping,
+// pairs of states an agent keeps bouncing between.
+//
+//  -run=AIBuilderStateHistory -File=<dump> [-Agent=<name>] [-FlapWindow=<seconds>] [-SummaryOnly]
+UCLASS()
+class UAIBuilderStateHistoryCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UAIBuilderStateHistoryCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,73 @@
+// AIBuilderDetectionTable.h - Actor keyed storage for sensor detections
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "AIBuilderDetectionTable.generated.h"
+
+USTRUCT(BlueprintType)
+struct FAISensorData
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    AActor* DetectedActor;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FVector LastKnownLocation;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float DetectionTime;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float Confidence;
+
+    FAISensorData()
+    {
+        DetectedActor = nullptr;
+        LastKnownLocation = FVector::ZeroVector;
+        DetectionTime = 0.0f;
+        Confidence = 0.0f;
+    }
+};
+
+// Dense array of detections with an actor index for O(1) lookup.
+// Removal swaps the last entry into the hole, so entry order is not stable.
+USTRUCT()
+struct AIBUILDER_API FAIDetectionTable
+{
+    GENERATED_BODY()
+
+    FAISensorData* Find(const AActor* Actor);
+    const FAISensorData* Find(const AActor* Actor) const;
+    bool Contains(const AActor* Actor) const;
+
+    // Returns the index of the entry for Actor, adding an empty one if it isn't tracked yet
+    int32 FindOrAdd(AActor* Actor, bool& bOutAdded);
+
+    // Call after raising the confidence of an entry to keep the best entry current
+    void OnConfidenceRaised(int32 Index);
+
+    // Entry with the highest confidence, or null when the table is empty
+    const FAISensorData* GetBest() const;
+
+    void RemoveAtSwap(int32 Index);
+    void Reset();
+
+    int32 Num() const { return Entries.Num(); }
+    FAISensorData& operator[](int32 Index) { return Entries[Index]; }
+    const FAISensorData& operator[](int32 Index) const { return Entries[Index]; }
+    const TArray<FAISensorData>& GetEntries() const { return Entries; }
+
+private:
+    UPROPERTY()
+    TArray<FAISensorData> Entries;
+
+    // Keys stay valid after the actor is destroyed, so stale entries can still be removed
+    TArray<TObjectKey<AActor>> Keys;
+    TMap<TObjectKey<AActor>, int32> IndexByActor;
+
+    // Maintained on insert, rescanned lazily only after the best entry is removed
+    mutable int32 BestIndex = INDEX_NONE;
+    mutable bool bBestDirty = false;
+};
@@ -4,34 +4,12 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Engine/Engine.h"
+#include "WorldCollision.h"
+#include "AIBuilderDetectionTable.h"
+#include "AIBuilderVisionCone.h"
+#include "Subsystems/AIBuilderSpatialGridSubsystem.h"
 #include "AIBuilderSensorComponent.generated.h"
 
-USTRUCT(BlueprintType)
-struct FAISensorData
-{
-    GENERATED_BODY()
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    AActor* DetectedActor;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    FVector LastKnownLocation;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    float DetectionTime;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite)
-    float Confidence;
-
-    FAISensorData()
-    {
-        DetectedActor = nullptr;
-        LastKnownLocation = FVector::ZeroVector;
-        DetectionTime = 0.0f;
-        Confidence = 0.0f;
-    }
-};
-
 UENUM(BlueprintType)
 enum class ESensorType : uint8
 {
@@ -54,6 +32,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 public:
@@ -74,6 +53,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Sight")
     float SightAngle = 90.0f;
 
+    // Line of sight traces are queued as async traces and consumed next frame
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Sight")
+    bool bUseAsyncSightTraces = false;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Hearing")
     bool bEnableHearingSensor = true;
 
@@ -89,6 +72,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|General")
     float UpdateFrequency = 0.1f;
 
+    // Let the world sensor scheduler drive updates instead of ticking this component
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|General")
+    bool bUseSensorScheduler = true;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|General")
     float ForgetTime = 5.0f;
 
@@ -108,44 +95,95 @@ public:
     UFUNCTION(BlueprintCallable, Category = "AI Builder")
     void SetSensorEnabled(ESensorType SensorType, bool bEnabled);
 
+    // Native read access to detections, none of these copy or allocate.
+    // Views are invalidated by the next sensor update.
+    TConstArrayView<FAISensorData> GetDetectionsView() const;
+    void ForEachDetection(TFunctionRef<void(const FAISensorData&)> Visitor) const;
+    const FAISensorData* GetBestDetection() const;
+
+    // Significance tier assigned by the sensor scheduler, INDEX_NONE for full fidelity
+    UPROPERTY(BlueprintReadOnly, Category = "AI Builder|General")
+    int32 CurrentLODTier = INDEX_NONE;
+
+    // Runs every enabled sensor once, called from the tick or the sensor scheduler.
+    // A LOD tier can switch off sensors that are enabled on the component, never the reverse.
+    void UpdateSensors(float DeltaTime, const struct FAISensorLODTier* LODTier = nullptr);
+
+    // UpdateSensors split into phases for batched updates. Begin and Finish run on the
+    // game thread; Evaluate only touches this component's snapshot and may run on any thread.
+    void BeginSensorUpdate(float DeltaTime, const struct FAISensorLODTier* LODTier = nullptr);
+    void EvaluateSensorUpdate();
+    void FinishSensorUpdate();
+
 protected:
     UPROPERTY()
-    TArray<FAISensorData> DetectedActors;
+    FAIDetectionTable Detections;
 
     float LastUpdateTime;
 
+    UPROPERTY()
+    class UAIBuilderSensorSchedulerSubsystem* SensorScheduler;
+
+    // World noise bus shared by all hearing sensors
+    UPROPERTY()
+    class UAIBuilderNoiseSubsystem* NoiseBus;
+
+    // Shared pawn grid used for sight and touch candidates
+    UPROPERTY()
+    class UAIBuilderSpatialGridSubsystem* SpatialGrid;
+
+    // Reused between updates to avoid per-query allocations
+    TArray<FAISensorCandidate> CandidateScratch;
+    FAIBuilderPositionSoA CandidatePositions;
+    TArray<int32> VisibleCandidateIndices;
+
+    // Sight snapshot and evaluation output carried between update phases
+    struct FSightResult
+    {
+        int32 CandidateIndex;
+        float Confidence;
+    };
+
+    struct FPendingSensorUpdate
+    {
+        float DeltaTime = 0.0f;
+        bool bSight = false;
+        bool bHearing = false;
+        bool bTouch = false;
+    };
+
+    FAIBuilderVisionCone SightCone;
+    TArray<FSightResult> SightResults;
+    FPendingSensorUpdate PendingUpdate;
+
+    // Sight traces waiting for their async result, keyed by trace user data
+    struct FPendingSightTrace
+    {
+        TWeakObjectPtr<AActor> Actor;
+        float Confidence;
+    };
+
+    TMap<uint32, FPendingSightTrace> PendingSightTraces;
+    uint32 NextSightTraceId;
+    FTraceDelegate SightTraceDelegate;
+
     // Sensor update functions
-    void UpdateSightSensor(float DeltaTime);
+    void GatherSightCandidates();
+    void EvaluateSightCandidates();
+    void ApplySightResults();
     void UpdateHearingSensor(float DeltaTime);
     void UpdateTouchSensor(float DeltaTime);
 
     // Utility functions
+    void GatherCandidates(float Range, TArray<FAISensorCandidate>& OutCandidates);
     bool CanSeeActor(AActor* Actor, FVector& OutHitLocation) const;
     float CalculateSightConfidence(AActor* Actor, float Distance) const;
     float CalculateHearingConfidence(FVector NoiseLocation, float Volume, float Distance) const;
 
+    // Async line of sight
+    void QueueSightTrace(AActor* Actor, const FVector& TargetLocation, float Confidence);
+    void OnSightTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
     void AddOrUpdateDetection(AActor* Actor, ESensorType SensorType, float Confidence, FVector Location);
     void RemoveOldDetections(float DeltaTime);
-
-    // Noise events for hearing
-    USTRUCT()
-    struct FNoiseEvent
-    {
-        GENERATED_BODY()
-
-        FVector Location;
-        float Volume;
-        float TimeStamp;
-        AActor* Instigator;
-
-        FNoiseEvent()
-        {
-            Location = FVector::ZeroVector;
-            Volume = 0.0f;
-            TimeStamp = 0.0f;
-            Instigator = nullptr;
-        }
-    };
-
-    TArray<FNoiseEvent> RecentNoiseEvents;
 };
\ No newline at end of file
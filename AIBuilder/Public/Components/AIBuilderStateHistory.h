@@ -0,0 +1,91 @@
+// AIBuilderStateHistory.h - Per agent state transition history and its binary dump format
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+// One state transition. States and reason are stored as the raw EAIBuilderState and
+// EAIBuilderTransitionReason values so the dump format does not depend on UHT types.
+struct FAIBuilderTransitionRecord
+{
+    float Time = 0.0f;
+
+    // -1 without a target
+    float TargetDistance = -1.0f;
+
+    // UObject unique ID of the target, 0 without a target
+    uint32 TargetId = 0;
+
+    uint8 OldState = 0;
+    uint8 NewState = 0;
+    uint8 Reason = 0;
+
+    // One bit per EAIBuilderConditionType of the rule that fired, 0 for manual changes
+    uint8 ConditionMask = 0;
+
+    friend FArchive& operator<<(FArchive& Ar, FAIBuilderTransitionRecord& Record)
+    {
+        Ar << Record.Time << Record.TargetDistance << Record.TargetId;
+        Ar << Record.OldState << Record.NewState << Record.Reason << Record.ConditionMask;
+        return Ar;
+    }
+};
+
+static_assert(sizeof(FAIBuilderTransitionRecord) == 16, "Transition records are meant to stay small");
+
+// Fixed size ring of the latest transitions. The game thread is the only writer and
+// never waits; readers on any thread take snapshots without locking and drop the
+// records the writer overwrote while they were copying.
+class AIBUILDER_API FAIBuilderStateHistory
+{
+public:
+    static constexpr uint32 Capacity = 64;
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    void Record(const FAIBuilderTransitionRecord& Record)
+    {
+        const uint32 Index = NumWritten.load(std::memory_order_relaxed);
+        Records[Index & (Capacity - 1)] = Record;
+        NumWritten.store(Index + 1, std::memory_order_release);
+    }
+
+    // Appends the surviving records to OutRecords, oldest first. Returns how many were added.
+    int32 Snapshot(TArray<FAIBuilderTransitionRecord>& OutRecords) const;
+
+    // Total number of transitions recorded, including the overwritten ones
+    uint32 GetNumWritten() const { return NumWritten.load(std::memory_order_acquire); }
+
+private:
+    FAIBuilderTransitionRecord Records[Capacity];
+    std::atomic<uint32> NumWritten{ 0 };
+};
+
+// Contents of a history dump, written by AIBuilder.DumpStateHistory and read by the
+// AIBuilderStateHistory commandlet
+struct AIBUILDER_API FAIBuilderStateHistoryDump
+{
+    struct FAgent
+    {
+        FString Name;
+        uint32 NumTransitions = 0;
+        TArray<FAIBuilderTransitionRecord> Records;
+    };
+
+    float CaptureTime = 0.0f;
+    TArray<FAgent> Agents;
+
+    // Target names resolved when the dump was written
+    TMap<uint32, FString> TargetNames;
+
+    // False when loading a file that is not a dump or comes from a newer version
+    bool Serialize(FArchive& Ar);
+
+    bool SaveToFile(const FString& Filename);
+    bool LoadFromFile(const FString& Filename);
+
+    // Gathers the history of every state machine in World
+    static FAIBuilderStateHistoryDump Capture(UWorld* World);
+
+    // Saved/AIBuilder/StateHistory-<timestamp>.aibh
+    static FString MakeDefaultFilename();
+};
@@ -3,6 +3,8 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Components/AIBuilderSensorComponent.h"
+#include "Components/AIBuilderStateHistory.h"
 #include "AIBuilderStateMachine.generated.h"
 
 UENUM(BlueprintType)
@@ -13,10 +15,80 @@ enum class EAIBuilderState : uint8
     Chase       UMETA(DisplayName = "Chase"),
     Attack      UMETA(DisplayName = "Attack"),
     Search      UMETA(DisplayName = "Search"),
-    Return      UMETA(DisplayName = "Return")
+    Return      UMETA(DisplayName = "Return"),
+
+    MAX         UMETA(Hidden)
+};
+
+// Conditions a state table rule can test
+UENUM(BlueprintType)
+enum class EAIBuilderConditionType : uint8
+{
+    HasTarget           UMETA(DisplayName = "Has Target"),
+    NoTarget            UMETA(DisplayName = "No Target"),
+    InAttackRange       UMETA(DisplayName = "In Attack Range"),
+    OutOfAttackRange    UMETA(DisplayName = "Out Of Attack Range"),
+    TimeInState         UMETA(DisplayName = "Time In State")
+};
+
+// Why a transition happened, kept in the transition history
+UENUM(BlueprintType)
+enum class EAIBuilderTransitionReason : uint8
+{
+    // ChangeState called from code or Blueprint
+    Manual      UMETA(DisplayName = "Manual"),
+
+    // An automatic rule of the state table fired
+    Rule        UMETA(DisplayName = "Rule")
+};
+
+UENUM(BlueprintType)
+enum class EAIBuilderStateUpdateMode : uint8
+{
+    // The owning character calls UpdateState on its own tick
+    PerAgent    UMETA(DisplayName = "Per Agent"),
+
+    // UAIBuilderStateBatchSubsystem updates all batched agents in one pass
+    Batched     UMETA(DisplayName = "Batched"),
+
+    // Transitions are evaluated on target and sensor events and on timers only
+    EventDriven UMETA(DisplayName = "Event Driven")
 };
 
+// Everything the transition conditions need to know about the target, computed
+// once per update. Blueprint and behavior tree services can read it instead of
+// measuring again; it is as fresh as the state machine's last update.
+USTRUCT(BlueprintType)
+struct FAIBuilderTargetContext
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "AI Builder")
+    AActor* Target = nullptr;
+
+    UPROPERTY(BlueprintReadOnly, Category = "AI Builder")
+    bool bHasTarget = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "AI Builder")
+    bool bInAttackRange = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "AI Builder")
+    float DistanceSquared = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "AI Builder")
+    float Distance = 0.0f;
+
+    // Unit vector from the agent towards the target, zero without a target
+    UPROPERTY(BlueprintReadOnly, Category = "AI Builder")
+    FVector Direction = FVector::ZeroVector;
+};
+
+struct FAIBuilderCompiledStateTable;
+class UAIBuilderStateBatchSubsystem;
+class UAIBuilderTimingWheelSubsystem;
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnStateChanged, EAIBuilderState, OldState, EAIBuilderState, NewState);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnSubStateChanged, FName, OldSubState, FName, NewSubState);
 
 UCLASS(ClassGroup=(AI), meta=(BlueprintSpawnableComponent))
 class AIBUILDER_API UAIBuilderStateMachine : public UActorComponent
@@ -28,12 +100,17 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 public:
     UPROPERTY(BlueprintAssignable, Category = "AI Builder|Events")
     FOnStateChanged OnStateChanged;
 
+    // Fires after OnStateChanged when the innermost sub-state changes, None means no sub-state
+    UPROPERTY(BlueprintAssignable, Category = "AI Builder|Events")
+    FOnSubStateChanged OnSubStateChanged;
+
     UPROPERTY(BlueprintReadOnly, Category = "AI Builder|State")
     EAIBuilderState CurrentState;
 
@@ -43,6 +120,28 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Configuration")
     float StateTransitionDelay = 0.5f;
 
+    // Transition rules, the built-in table is used when none is set
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Configuration")
+    class UAIBuilderStateTable* StateTable;
+
+    // Sub-states registered for this archetype are used on top of the shared ones, see FAIBuilderSubStateRegistry.
+    // Change it only while no sub-state is active.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Configuration")
+    FName SubStateArchetype;
+
+    // Read when the state machine is initialized
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI Builder|Configuration")
+    EAIBuilderStateUpdateMode UpdateMode = EAIBuilderStateUpdateMode::PerAgent;
+
+    // Event driven only. Distance to the target changes without an event, so while
+    // the current state has attack range rules and a target, they are re-checked this often.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Configuration", meta = (ClampMin = "0.05"))
+    float RangeCheckInterval = 0.1f;
+
+    // Keeps the last transitions in a small ring buffer for AIBuilder.DumpStateHistory. Read at BeginPlay.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI Builder|Debug")
+    bool bRecordHistory = true;
+
     // Blueprint callable functions
     UFUNCTION(BlueprintCallable, Category = "AI Builder")
     void ChangeState(EAIBuilderState NewState);
@@ -59,27 +158,98 @@ public:
     UFUNCTION(BlueprintPure, Category = "AI Builder")
     FString GetCurrentStateName() const;
 
+    // Switches to a registered sub-state of the current state, entering its default children.
+    // None leaves all sub-states. Must not be called from a sub-state's Enter or Exit.
+    UFUNCTION(BlueprintCallable, Category = "AI Builder")
+    bool ChangeSubState(FName SubState);
+
+    // Path of the innermost active sub-state, e.g. "Attack.Melee.Combo"
+    UFUNCTION(BlueprintPure, Category = "AI Builder")
+    FName GetCurrentSubState() const;
+
+    // True when SubState or one of its children is active
+    UFUNCTION(BlueprintPure, Category = "AI Builder")
+    bool IsInSubState(FName SubState) const;
+
+    UFUNCTION(BlueprintPure, Category = "AI Builder")
+    const FAIBuilderTargetContext& GetTargetContext() const { return TargetContext; }
+
+    // True while the batch subsystem owns this state machine's updates
+    bool IsBatched() const { return BatchSubsystem != nullptr; }
+
+    // True while transitions are only evaluated on events and timers
+    bool IsEventDriven() const { return TimingWheel != nullptr; }
+
+    // Called by the timing wheel, tokens of superseded timers are ignored
+    void OnTimingWheelFired(uint32 Token);
+
+    // Null unless bRecordHistory was set at BeginPlay
+    const FAIBuilderStateHistory* GetHistory() const { return History.Get(); }
+
 protected:
     UPROPERTY()
     class AAIBuilderCharacter* OwnerCharacter;
 
     float StateTimer;
     float LastTransitionTime;
+    float StateEnterTime;
+
+    UPROPERTY(Transient)
+    FAIBuilderTargetContext TargetContext;
+
+    // Refreshes TargetContext from the owner and its current target
+    void UpdateTargetContext();
+
+    // Fills TargetContext from a distance the caller already measured, Target may be null
+    void SetTargetContext(AActor* Target, const FVector& Delta, float DistanceSquared, bool bInAttackRange);
 
-    // State logic functions
-    void UpdateIdleState(float DeltaTime);
-    void UpdatePatrolState(float DeltaTime);
-    void UpdateChaseState(float DeltaTime);
-    void UpdateAttackState(float DeltaTime);
-    void UpdateSearchState(float DeltaTime);
-    void UpdateReturnState(float DeltaTime);
+    // Transition table lookup
+    const FAIBuilderCompiledStateTable& GetTransitionTable() const;
 
     // State transition functions
+    void TryChangeState(EAIBuilderState NewState, EAIBuilderTransitionReason Reason, uint32 ConditionMask);
     void EnterState(EAIBuilderState NewState);
     void ExitState(EAIBuilderState OldState);
 
+    // Sub-state stack, LeafIndex INDEX_NONE leaves every sub-state
+    void SwitchSubStates(int32 LeafIndex);
+    void UpdateSubStates(float DeltaTime);
+
+    // Event driven evaluation
+    void ReevaluateTransitions();
+    void ScheduleNextEvaluation(bool bRetryAfterTransitionDelay);
+    void HandleTargetChanged(AActor* OldTarget, AActor* NewTarget);
+
+    UFUNCTION()
+    void HandleActorDetected(AActor* DetectedActor, ESensorType SensorType, float Confidence);
+
+    UFUNCTION()
+    void HandleActorLost(AActor* LostActor, ESensorType SensorType);
+
     // Utility functions
     bool HasValidTarget() const;
-    float GetDistanceToTarget() const;
-    bool IsInAttackRange() const;
+
+    // As of the last update, see TargetContext
+    bool IsInAttackRange() const { return TargetContext.bInAttackRange; }
+
+private:
+    friend class UAIBuilderStateBatchSubsystem;
+
+    // Set while registered with the batch subsystem, BatchIndex is our slot in its arrays
+    UAIBuilderStateBatchSubsystem* BatchSubsystem;
+    int32 BatchIndex;
+
+    // Set while event driven. Only the timer carrying WheelToken is still wanted.
+    UAIBuilderTimingWheelSubsystem* TimingWheel;
+    uint32 WheelToken;
+
+    // Registry indices of the active sub-states, outermost first
+    TArray<int32, TInlineAllocator<4>> SubStateStack;
+    float SubStateEnterTime;
+
+    // Bumped on every switch so updates notice when a hook changed the stack under them
+    uint32 SubStateSerial;
+    bool bSwitchingSubStates;
+
+    TUniquePtr<FAIBuilderStateHistory> History;
 };
\ No newline at end of file
@@ -0,0 +1,166 @@
+// AIBuilderStateTable.h - Data driven state transition table
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Components/AIBuilderStateMachine.h"
+#include "AIBuilderStateTable.generated.h"
+
+USTRUCT(BlueprintType)
+struct FAIBuilderTransitionCondition
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder")
+    EAIBuilderConditionType Type = EAIBuilderConditionType::HasTarget;
+
+    // Seconds for TimeInState, unused by the other conditions
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder")
+    float Value = 0.0f;
+
+    FAIBuilderTransitionCondition() = default;
+
+    FAIBuilderTransitionCondition(EAIBuilderConditionType InType, float InValue = 0.0f)
+        : Type(InType)
+        , Value(InValue)
+    {
+    }
+};
+
+USTRUCT(BlueprintType)
+struct FAIBuilderTransitionRule
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder")
+    EAIBuilderState From = EAIBuilderState::Idle;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder")
+    EAIBuilderState To = EAIBuilderState::Idle;
+
+    // Manual rules only allow ChangeState calls and are never taken by UpdateState
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder")
+    bool bManual = false;
+
+    // All conditions must hold for the rule to fire
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder")
+    TArray<FAIBuilderTransitionCondition> Conditions;
+
+    FAIBuilderTransitionRule() = default;
+
+    FAIBuilderTransitionRule(EAIBuilderState InFrom, EAIBuilderState InTo, TArray<FAIBuilderTransitionCondition> InConditions, bool bInManual = false)
+        : From(InFrom)
+        , To(InTo)
+        , bManual(bInManual)
+        , Conditions(MoveTemp(InConditions))
+    {
+    }
+};
+
+// Flat form of a rule list. Checking whether a transition is allowed is a single
+// bit test, and the automatic rules of a state are one contiguous range.
+struct AIBUILDER_API FAIBuilderCompiledStateTable
+{
+    static constexpr int32 NumStates = static_cast<int32>(EAIBuilderState::MAX);
+    static_assert(NumStates <= 32, "Allowed transitions are stored as a 32 bit mask per state");
+
+    struct FCondition
+    {
+        EAIBuilderConditionType Type;
+        float Value;
+    };
+
+    struct FRule
+    {
+        EAIBuilderState To;
+        int32 FirstCondition;
+        int32 NumConditions;
+    };
+
+    struct FStateEntry
+    {
+        uint32 AllowedMask = 0;
+        int32 FirstRule = 0;
+        int32 NumRules = 0;
+
+        // One bit per EAIBuilderConditionType used by the state's automatic rules
+        uint32 ConditionMask = 0;
+    };
+
+    // What the conditions are tested against, gathered once per update
+    struct FConditionInputs
+    {
+        bool bHasTarget;
+        bool bInAttackRange;
+        float TimeInState;
+    };
+
+    void Compile(TConstArrayView<FAIBuilderTransitionRule> Rules);
+
+    bool IsAllowed(EAIBuilderState From, EAIBuilderState To) const
+    {
+        return (States[static_cast<int32>(From)].AllowedMask & (1u << static_cast<uint32>(To))) != 0;
+    }
+
+    // Automatic rules leaving From, in authored order
+    TConstArrayView<FRule> GetRules(EAIBuilderState From) const
+    {
+        const FStateEntry& Entry = States[static_cast<int32>(From)];
+        return TConstArrayView<FRule>(Rules.GetData() + Entry.FirstRule, Entry.NumRules);
+    }
+
+    TConstArrayView<FCondition> GetConditions(const FRule& Rule) const
+    {
+        return TConstArrayView<FCondition>(Conditions.GetData() + Rule.FirstCondition, Rule.NumConditions);
+    }
+
+    // Finds the first automatic rule leaving From whose conditions all hold.
+    // OutConditionMask receives one bit per condition type of that rule.
+    bool FindTransition(EAIBuilderState From, const FConditionInputs& Inputs, EAIBuilderState& OutTo, uint32* OutConditionMask = nullptr) const;
+
+    bool UsesCondition(EAIBuilderState From, EAIBuilderConditionType Type) const
+    {
+        return (States[static_cast<int32>(From)].ConditionMask & (1u << static_cast<uint32>(Type))) != 0;
+    }
+
+    // Smallest TimeInState threshold of From's rules that has not been passed yet,
+    // or TNumericLimits<float>::Max() when no timed rule is left
+    float FindNextTimeThreshold(EAIBuilderState From, float TimeInState) const;
+
+private:
+    FStateEntry States[NumStates];
+    TArray<FRule> Rules;
+    TArray<FCondition> Conditions;
+};
+
+UCLASS(BlueprintType)
+class AIBUILDER_API UAIBuilderStateTable : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    UAIBuilderStateTable();
+
+    virtual void PostInitProperties() override;
+    virtual void PostLoad() override;
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+    // Automatic rules are tried in order and the first one whose conditions hold is taken
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI Builder")
+    TArray<FAIBuilderTransitionRule> Transitions;
+
+    // Rebuilds the flat table, call after changing Transitions at runtime
+    UFUNCTION(BlueprintCallable, Category = "AI Builder")
+    void Compile();
+
+    const FAIBuilderCompiledStateTable& GetCompiledTable() const { return CompiledTable; }
+
+    // The built-in rules, used by state machines without a table asset
+    static void GetDefaultTransitions(TArray<FAIBuilderTransitionRule>& OutTransitions);
+    static const FAIBuilderCompiledStateTable& GetDefaultCompiledTable();
+
+private:
+    FAIBuilderCompiledStateTable CompiledTable;
+};
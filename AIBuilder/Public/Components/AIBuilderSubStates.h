@@ -0,0 +1,136 @@
+// AIBuilderSubStates.h - Hierarchical sub-states registered from C++
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/AIBuilderStateMachine.h"
+
+class AAIBuilderCharacter;
+
+// Passed to every sub-state hook
+struct FAIBuilderSubStateContext
+{
+    UAIBuilderStateMachine* StateMachine;
+    AAIBuilderCharacter* Character;
+    const FAIBuilderTargetContext& Target;
+
+    // Seconds since the innermost active sub-state was entered
+    float TimeInSubState;
+};
+
+// Base for sub-state types. The hooks are static and hidden rather than overridden,
+// so a type only declares the ones it needs and dispatch never touches a vtable.
+//
+//  struct FMeleeAttackState : FAIBuilderSubState
+//  {
+//      static void Enter(FAIBuilderSubStateContext& Context);
+//  };
+//  AIBUILDER_REGISTER_SUBSTATE(FMeleeAttackState, EAIBuilderState::Attack, TEXT("Attack.Melee"), true);
+//  AIBUILDER_REGISTER_ARCHETYPE_SUBSTATE(FSniperAttackState, TEXT("Sniper"), EAIBuilderState::Attack, TEXT("Attack.Ranged"), true);
+struct FAIBuilderSubState
+{
+    static void Enter(FAIBuilderSubStateContext& Context) {}
+    static void Update(FAIBuilderSubStateContext& Context, float DeltaTime) {}
+    static void Exit(FAIBuilderSubStateContext& Context) {}
+};
+
+struct FAIBuilderSubStateDesc
+{
+    using FEnterFunc = void (*)(FAIBuilderSubStateContext&);
+    using FUpdateFunc = void (*)(FAIBuilderSubStateContext&, float);
+    using FExitFunc = void (*)(FAIBuilderSubStateContext&);
+
+    // Full dotted path starting with the top level state, e.g. "Attack.Melee.Combo"
+    const TCHAR* PathString;
+    FName Path;
+    EAIBuilderState RootState;
+    bool bIsDefault;
+
+    // Null and None for sub-states every archetype shares
+    const TCHAR* ArchetypeString;
+    FName Archetype;
+
+    FEnterFunc Enter;
+    FUpdateFunc Update;
+    FExitFunc Exit;
+};
+
+// Flat table of every registered sub-state. Entries are added during static
+// initialization and never removed, so indices stay valid for the whole run.
+//
+// State machines see the sub-states of their SubStateArchetype: the shared ones plus those
+// registered for the archetype, which replace shared ones with the same path. Parents and
+// defaults are resolved separately for each archetype. Unknown archetypes see the shared set.
+class AIBUILDER_API FAIBuilderSubStateRegistry
+{
+public:
+    static FAIBuilderSubStateRegistry& Get();
+
+    // Archetype null registers a sub-state shared by every archetype
+    void Register(const TCHAR* Archetype, EAIBuilderState RootState, const TCHAR* Path, bool bIsDefault,
+                  FAIBuilderSubStateDesc::FEnterFunc Enter, FAIBuilderSubStateDesc::FUpdateFunc Update, FAIBuilderSubStateDesc::FExitFunc Exit);
+
+    // INDEX_NONE for paths the archetype doesn't have
+    int32 Find(FName Archetype, FName Path);
+
+    const FAIBuilderSubStateDesc& GetDesc(int32 Index) const { return States[Index]; }
+
+    // Follows the archetype's default children down from Index. INDEX_NONE stays INDEX_NONE.
+    int32 GetDefaultLeaf(FName Archetype, int32 Index);
+
+    // Same, starting from the archetype's default sub-state of RootState
+    int32 GetDefaultLeaf(FName Archetype, EAIBuilderState RootState);
+
+    // Outermost first, ending with Index
+    void GetChain(FName Archetype, int32 Index, TArray<int32, TInlineAllocator<4>>& OutChain);
+
+    int32 Num() const { return States.Num(); }
+
+private:
+    FAIBuilderSubStateRegistry();
+
+    // The sub-states one archetype sees, with its parents and defaults
+    struct FArchetypeView
+    {
+        FName Name;
+        TMap<FName, int32> PathToIndex;
+
+        // Indexed like States, INDEX_NONE for sub-states outside the archetype.
+        // ParentIndex is INDEX_NONE directly below the root state.
+        TArray<int32> ParentIndices;
+        TArray<int32> DefaultChildIndices;
+        int32 RootDefaults[static_cast<int32>(EAIBuilderState::MAX)];
+    };
+
+    // Registration order across translation units is unspecified, so parents are linked on first use
+    void Finalize();
+    void BuildArchetypeView(FArchetypeView& View);
+
+    const FArchetypeView& GetArchetypeView(FName Archetype);
+
+    TArray<FAIBuilderSubStateDesc> States;
+
+    // The shared view comes first
+    TArray<FArchetypeView> ArchetypeViews;
+    TMap<FName, int32> ArchetypeToView;
+    bool bFinalized;
+};
+
+template <typename TSubState>
+struct TAIBuilderSubStateRegistrar
+{
+    static_assert(TIsDerivedFrom<TSubState, FAIBuilderSubState>::Value, "Sub-states must derive from FAIBuilderSubState");
+
+    TAIBuilderSubStateRegistrar(const TCHAR* Archetype, EAIBuilderState RootState, const TCHAR* Path, bool bIsDefault)
+    {
+        FAIBuilderSubStateRegistry::Get().Register(Archetype, RootState, Path, bIsDefault, &TSubState::Enter, &TSubState::Update, &TSubState::Exit);
+    }
+};
+
+// Registers a sub-state type from a .cpp file for every archetype. Default sub-states
+// are entered automatically together with their parent.
+#define AIBUILDER_REGISTER_SUBSTATE(Type, RootState, Path, bIsDefault) \
+    static const TAIBuilderSubStateRegistrar<Type> PREPROCESSOR_JOIN(AIBuilderSubStateRegistrar_##Type##_, __LINE__)(nullptr, RootState, Path, bIsDefault)
+
+// Same, only for state machines whose SubStateArchetype is Archetype
+#define AIBUILDER_REGISTER_ARCHETYPE_SUBSTATE(Type, Archetype, RootState, Path, bIsDefault) \
+    static const TAIBuilderSubStateRegistrar<Type> PREPROCESSOR_JOIN(AIBuilderSubStateRegistrar_##Type##_, __LINE__)(Archetype, RootState, Path, bIsDefault)
@@ -0,0 +1,48 @@
+// AIBuilderVisionCone.h - Vectorized view cone and range filtering
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Target positions in structure-of-arrays layout. The arrays are padded to a
+// multiple of four with unreachable positions so the kernel always loads full lanes.
+struct AIBUILDER_API FAIBuilderPositionSoA
+{
+    TArray<float, TAlignedHeapAllocator<16>> X;
+    TArray<float, TAlignedHeapAllocator<16>> Y;
+    TArray<float, TAlignedHeapAllocator<16>> Z;
+
+    void Reset();
+    void Add(const FVector& Location);
+
+    // Number of real positions, without padding
+    int32 Num() const { return NumPositions; }
+    int32 NumPadded() const { return X.Num(); }
+
+private:
+    int32 NumPositions = 0;
+};
+
+// A viewer's sight cone, precomputed so that testing a target needs no
+// square roots or trigonometry
+struct AIBUILDER_API FAIBuilderVisionCone
+{
+    FVector3f Origin;
+    FVector3f Forward;
+    float CosHalfAngle;
+    float RangeSquared;
+
+    FAIBuilderVisionCone();
+    FAIBuilderVisionCone(const FVector& InOrigin, const FVector& InForward, float SightAngleDegrees, float Range);
+
+    // Appends the indices of targets inside the cone and range to OutIndices
+    void FilterTargets(const FAIBuilderPositionSoA& Targets, TArray<int32>& OutIndices) const;
+
+    // Tests every viewer against every target. OutMasks receives one row of
+    // GetMaskWordsPerRow bits per viewer, bit N set when target N is visible.
+    static void FilterTargetsBatch(TConstArrayView<FAIBuilderVisionCone> Viewers, const FAIBuilderPositionSoA& Targets, TArray<uint32>& OutMasks);
+    static int32 GetMaskWordsPerRow(const FAIBuilderPositionSoA& Targets);
+
+private:
+    // Returns a 4 bit mask for the targets starting at Index
+    uint32 TestGroup(const FAIBuilderPositionSoA& Targets, int32 Index) const;
+};
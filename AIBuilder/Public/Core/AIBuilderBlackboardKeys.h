@@ -0,0 +1,30 @@
+// AIBuilderBlackboardKeys.h - Cached blackboard key IDs and change-only setters
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BlackboardComponent.h"
+
+// Blackboard key IDs of the values AIBuilder writes, looked up once per blackboard asset
+// instead of by name on every write
+struct AIBUILDER_API FAIBuilderBlackboardKeys
+{
+    FBlackboard::FKey TargetActor = FBlackboard::InvalidKey;
+    FBlackboard::FKey TargetLocation = FBlackboard::InvalidKey;
+    FBlackboard::FKey HasTarget = FBlackboard::InvalidKey;
+
+    // Only looks the keys up again when Blackboard uses a different asset than last time.
+    // False when there is no blackboard asset to write to.
+    bool Resolve(const UBlackboardComponent* Blackboard);
+
+    // Writes TargetActor and HasTarget, and TargetLocation when there is a target
+    void SetTarget(UBlackboardComponent* Blackboard, AActor* Target);
+    AActor* GetTarget(const UBlackboardComponent* Blackboard);
+
+    // Write by key ID and skip values that are already set, so observers only hear about real changes
+    static void SetObject(UBlackboardComponent* Blackboard, FBlackboard::FKey Key, UObject* Value);
+    static void SetVector(UBlackboardComponent* Blackboard, FBlackboard::FKey Key, const FVector& Value);
+    static void SetBool(UBlackboardComponent* Blackboard, FBlackboard::FKey Key, bool Value);
+
+private:
+    TWeakObjectPtr<const UBlackboardData> ResolvedAsset;
+};
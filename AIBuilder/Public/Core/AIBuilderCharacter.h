@@ -8,8 +8,24 @@
 #include "BehaviorTree/BlackboardComponent.h"
 #include "AIBuilderStateMachine.h"
 #include "AIBuilderSensorComponent.h"
+#include "AIBuilderBlackboardKeys.h"
 #include "AIBuilderCharacter.generated.h"
 
+class UAIBuilderTickManagerSubsystem;
+
+UENUM(BlueprintType)
+enum class EAIBuilderPerceptionMode : uint8
+{
+    // The sensor component is the only source of detections. It drives the current
+    // target and the blackboard, and neither perception component configures senses.
+    Unified     UMETA(DisplayName = "Unified"),
+
+    // Character and controller each run their own UAIPerceptionComponent next to the sensor component
+    Legacy      UMETA(DisplayName = "Legacy")
+};
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnAIBuilderTargetChanged, AActor* /*OldTarget*/, AActor* /*NewTarget*/);
+
 UCLASS(BlueprintType, Blueprintable)
 class AIBUILDER_API AAIBuilderCharacter : public ACharacter
 {
@@ -20,6 +36,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void Tick(float DeltaTime) override;
 
     // AI Components
@@ -45,6 +62,10 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Configuration")
     class UBlackboardAsset* BlackboardAsset;
 
+    // Read at BeginPlay and when the controller possesses us
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI Builder|Configuration")
+    EAIBuilderPerceptionMode PerceptionMode = EAIBuilderPerceptionMode::Unified;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Configuration")
     float SightRadius = 1500.0f;
 
@@ -64,6 +85,15 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Behavior")
     float PatrolRadius = 1000.0f;
 
+    // Seconds between AI updates, 0 updates every frame
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Performance", meta = (ClampMin = "0.0"))
+    float AIUpdateInterval = 0.1f;
+
+    // Let UAIBuilderTickManagerSubsystem run the AI update. Read at BeginPlay. The actor tick is
+    // switched off unless the class implements Event Tick, which then keeps running.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI Builder|Performance")
+    bool bUseAITickManager = true;
+
 public:
     // Blueprint callable functions
     UFUNCTION(BlueprintCallable, Category = "AI Builder")
@@ -81,6 +111,13 @@ public:
     UFUNCTION(BlueprintCallable, Category = "AI Builder")
     void SetCurrentTarget(AActor* NewTarget);
 
+    FORCEINLINE UAIBuilderSensorComponent* GetSensorComponent() const { return SensorComponent; }
+    FORCEINLINE UAIBuilderStateMachine* GetStateMachine() const { return StateMachine; }
+    FORCEINLINE bool UsesUnifiedPerception() const { return PerceptionMode == EAIBuilderPerceptionMode::Unified; }
+
+    // Broadcast when the current target changes, including when it is destroyed
+    FOnAIBuilderTargetChanged OnTargetChanged;
+
 protected:
     // Perception callbacks
     UFUNCTION()
@@ -89,13 +126,38 @@ protected:
     UFUNCTION()
     void OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus Stimulus);
 
+    UFUNCTION()
+    void OnCurrentTargetDestroyed(AActor* DestroyedActor);
+
+    // Unified perception, sensor events only trigger a refresh from the detection table
+    UFUNCTION()
+    void OnSensorActorDetected(AActor* DetectedActor, ESensorType SensorType, float Confidence);
+
+    UFUNCTION()
+    void OnSensorActorLost(AActor* LostActor, ESensorType SensorType);
+
 private:
+    friend class UAIBuilderTickManagerSubsystem;
+
     void InitializeAI();
     void SetupPerception();
+    void SetupUnifiedPerception();
+
+    // Keeps the current target while the sensor still detects it, otherwise takes the best detection
+    void RefreshTargetFromSensor();
     void UpdateAIState(float DeltaTime);
 
+    // Everything the character does per AI update, ElapsedTime is the time since the last one
+    void UpdateAI(float ElapsedTime);
+
     UPROPERTY()
     AActor* CurrentTarget;
 
     float LastUpdateTime;
+
+    FAIBuilderBlackboardKeys BlackboardKeys;
+
+    // Set while registered with the tick manager, AITickIndex is our slot in its arrays
+    UAIBuilderTickManagerSubsystem* AITickManager;
+    int32 AITickIndex;
 };
\ No newline at end of file
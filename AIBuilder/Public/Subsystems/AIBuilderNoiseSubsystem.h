@@ -0,0 +1,66 @@
+// AIBuilderNoiseSubsystem.h - World level noise bus for hearing sensors
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AIBuilderNoiseSubsystem.generated.h"
+
+struct FAIBuilderNoiseEvent
+{
+    FVector Location = FVector::ZeroVector;
+    float Volume = 0.0f;
+    float TimeStamp = 0.0f;
+    TWeakObjectPtr<AActor> Instigator;
+
+    // Bumped each time the ring slot is reused, so stale cell entries can be detected
+    uint32 Sequence = 0;
+
+    // Grid cell holding this event's entry, kept so the entry can be removed when the slot is reused
+    FIntPoint Cell = FIntPoint::ZeroValue;
+};
+
+UCLASS()
+class AIBUILDER_API UAIBuilderNoiseSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UAIBuilderNoiseSubsystem();
+
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+    // Edge length of a grid cell in world units, roughly the typical hearing range
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Hearing")
+    float CellSize = 1000.0f;
+
+    // Seconds a noise stays audible after it was reported
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Hearing")
+    float EventLifetime = 2.0f;
+
+    // Maximum number of live noise events, the oldest is overwritten when full
+    static constexpr int32 Capacity = 1024;
+
+    UFUNCTION(BlueprintCallable, Category = "AI Builder")
+    void ReportNoise(FVector Location, float Volume, AActor* Instigator = nullptr);
+
+    // Calls Visitor for every live noise event within Range of ListenerLocation
+    void QueryNoise(const FVector& ListenerLocation, float Range, TFunctionRef<void(const FAIBuilderNoiseEvent&)> Visitor);
+
+private:
+    struct FCellEntry
+    {
+        int32 Slot;
+        uint32 Sequence;
+    };
+
+    TArray<FAIBuilderNoiseEvent> Events;
+    int32 NextSlot;
+    uint32 NextSequence;
+
+    // At most one entry per ring slot: reusing a slot removes its old entry, and queries prune expired ones
+    TMap<FIntPoint, TArray<FCellEntry>> Cells;
+
+    FIntPoint GetCellCoord(const FVector& Location) const;
+    void RemoveCellEntry(const FIntPoint& Cell, int32 Slot, uint32 Sequence);
+};
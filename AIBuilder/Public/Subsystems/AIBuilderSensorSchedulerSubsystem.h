@@ -0,0 +1,122 @@
+// AIBuilderSensorSchedulerSubsystem.h - Budgeted update scheduler for sensor components
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AIBuilderSensorSchedulerSubsystem.generated.h"
+
+class UAIBuilderSensorComponent;
+
+// One significance level for sensors, picked by distance to the nearest player view
+USTRUCT(BlueprintType)
+struct FAISensorLODTier
+{
+    GENERATED_BODY()
+
+    // Agents closer than this to the nearest player view use this tier
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Sensors")
+    float MaxDistance = 0.0f;
+
+    // Multiplies the sensor's UpdateFrequency
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Sensors")
+    float UpdateIntervalScale = 1.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Sensors")
+    bool bEnableSight = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Sensors")
+    bool bEnableHearing = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Sensors")
+    bool bEnableTouch = true;
+
+    FAISensorLODTier() = default;
+
+    FAISensorLODTier(float InMaxDistance, float InUpdateIntervalScale, bool bInEnableSight, bool bInEnableHearing, bool bInEnableTouch)
+        : MaxDistance(InMaxDistance)
+        , UpdateIntervalScale(InUpdateIntervalScale)
+        , bEnableSight(bInEnableSight)
+        , bEnableHearing(bInEnableHearing)
+        , bEnableTouch(bInEnableTouch)
+    {
+    }
+};
+
+// Timings of the most recent scheduler tick, used to measure parallel scaling
+struct FAISensorSchedulerFrameStats
+{
+    int32 SensorsUpdated = 0;
+    double GatherMs = 0.0;
+    double EvaluateMs = 0.0;
+    double ApplyMs = 0.0;
+    bool bParallel = false;
+};
+
+UCLASS(config = Game)
+class AIBUILDER_API UAIBuilderSensorSchedulerSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UAIBuilderSensorSchedulerSubsystem();
+
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Wall clock time in milliseconds the scheduler may spend on sensor updates per frame.
+    // Sensors that don't fit are updated first on the next frame.
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Sensors")
+    float FrameBudgetMs = 1.0f;
+
+    // Significance tiers ordered by ascending MaxDistance, agents beyond the last one use the last
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Sensors")
+    TArray<FAISensorLODTier> LODTiers;
+
+    // Drop agents beyond the first tier that haven't been rendered recently one tier further
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Sensors")
+    bool bDemoteOffscreenAgents = true;
+
+    // Evaluate sight for each batch of sensors across worker threads
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Sensors")
+    bool bParallelSensorEvaluation = true;
+
+    // Number of sensors snapshotted and evaluated together
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Sensors")
+    int32 ParallelBatchSize = 64;
+
+    // Takes over updating of the sensor and disables its component tick
+    void RegisterSensor(UAIBuilderSensorComponent* Sensor);
+    void UnregisterSensor(UAIBuilderSensorComponent* Sensor);
+
+    UFUNCTION(BlueprintCallable, Category = "AI Builder")
+    int32 GetNumRegisteredSensors() const;
+
+    const FAISensorSchedulerFrameStats& GetLastFrameStats() const;
+
+private:
+    struct FScheduledSensor
+    {
+        TWeakObjectPtr<UAIBuilderSensorComponent> Sensor;
+        double NextUpdateTime;
+        double LastUpdateTime;
+    };
+
+    TArray<FScheduledSensor> Sensors;
+
+    // Sensors of the batch being processed, only valid during Tick
+    TArray<UAIBuilderSensorComponent*> Batch;
+
+    FAISensorSchedulerFrameStats LastFrameStats;
+
+    // Player view locations, gathered once per tick
+    TArray<FVector> ViewLocations;
+
+    void GatherViewLocations();
+    int32 ComputeLODTier(const UAIBuilderSensorComponent* Sensor) const;
+
+    // Round robin position, so sensors skipped by the budget go first next frame
+    int32 Cursor;
+
+    bool bIsTicking;
+};
@@ -0,0 +1,62 @@
+// AIBuilderSpatialGridSubsystem.h - Shared spatial hash of sensable pawns
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AIBuilderSpatialGridSubsystem.generated.h"
+
+// A pawn returned by a grid query, with the location it had when the grid was built
+struct FAISensorCandidate
+{
+    AActor* Actor = nullptr;
+    FVector Location = FVector::ZeroVector;
+};
+
+UCLASS()
+class AIBUILDER_API UAIBuilderSpatialGridSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UAIBuilderSpatialGridSubsystem();
+
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+    // Edge length of a grid cell in world units, roughly the typical sight range
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Spatial Grid")
+    float CellSize = 1500.0f;
+
+    // Appends every tracked pawn within Radius of Center to OutCandidates
+    void QuerySphere(const FVector& Center, float Radius, const AActor* IgnoreActor, TArray<FAISensorCandidate>& OutCandidates);
+
+    // Rebuilds the grid if it has not been built yet this frame
+    void EnsureUpToDate();
+
+    UFUNCTION(BlueprintCallable, Category = "AI Builder")
+    int32 GetNumTrackedPawns() const;
+
+private:
+    struct FGridEntry
+    {
+        AActor* Actor;
+        FVector Location;
+        FIntPoint Cell;
+    };
+
+    struct FCellRange
+    {
+        int32 Start;
+        int32 Num;
+    };
+
+    // Entries sorted by cell so that each cell is a contiguous range.
+    // Actor pointers are only valid for the frame the grid was built in,
+    // every query goes through EnsureUpToDate before touching them.
+    TArray<FGridEntry> Entries;
+    TMap<FIntPoint, FCellRange> Cells;
+
+    uint64 LastBuildFrame;
+
+    void RebuildGrid();
+    FIntPoint GetCellCoord(const FVector& Location) const;
+};
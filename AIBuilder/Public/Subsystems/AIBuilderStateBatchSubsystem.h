@@ -0,0 +1,65 @@
+// AIBuilderStateBatchSubsystem.h - Batched state machine evaluation for all agents
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/AIBuilderStateMachine.h"
+#include "AIBuilderStateBatchSubsystem.generated.h"
+
+// Keeps the state of every batched agent in parallel arrays and evaluates all
+// transitions in one pass per frame. Only agents whose state changes are written back.
+UCLASS()
+class AIBUILDER_API UAIBuilderStateBatchSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UAIBuilderStateBatchSubsystem();
+
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    void RegisterStateMachine(UAIBuilderStateMachine* StateMachine);
+    void UnregisterStateMachine(UAIBuilderStateMachine* StateMachine);
+
+    // Called by a batched state machine whenever it changes state, including from Blueprint
+    void NotifyStateChanged(int32 Index, EAIBuilderState NewState, float TransitionTime);
+
+    int32 GetNumAgents() const { return Machines.Num(); }
+
+private:
+    struct FPendingTransition
+    {
+        int32 Index;
+        EAIBuilderState To;
+        uint32 ConditionMask;
+    };
+
+    // One slot per agent, every array shares the same index
+    TArray<TWeakObjectPtr<UAIBuilderStateMachine>> Machines;
+    TArray<const FAIBuilderCompiledStateTable*> Tables;
+    TArray<EAIBuilderState> States;
+    TArray<float> StateTimers;
+    TArray<float> LastTransitionTimes;
+    TArray<float> TransitionDelays;
+    TArray<FVector> TargetDeltas;
+    TArray<float> TargetDistancesSquared;
+    TArray<float> AttackRangesSquared;
+    TArray<uint8> HasTarget;
+    TArray<uint8> InAttackRange;
+
+    // Current targets, only valid between GatherInputs and PublishTargetContexts
+    TArray<AActor*> Targets;
+
+    TArray<FPendingTransition> PendingTransitions;
+
+    // Unregistering while ticking only clears the slot, the arrays are compacted afterwards
+    bool bIsTicking;
+    bool bHasStaleSlots;
+
+    void GatherInputs();
+    void PublishTargetContexts();
+    void RemoveSlot(int32 Index);
+    void RemoveStaleSlots();
+};
@@ -0,0 +1,50 @@
+// AIBuilderTickManagerSubsystem.h - Staggered AI updates for all AIBuilder characters
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AIBuilderTickManagerSubsystem.generated.h"
+
+class AAIBuilderCharacter;
+
+// Runs the AI update of every registered character from one loop instead of one actor
+// tick each. Agents are spread over phase buckets so their updates don't land on the
+// same frame, and each agent keeps its own update interval.
+UCLASS(config = Game)
+class AIBUILDER_API UAIBuilderTickManagerSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UAIBuilderTickManagerSubsystem();
+
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Evenly spaced phase offsets within an agent's interval, assigned round robin on registration
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "AI Builder|Performance", meta = (ClampMin = "1"))
+    int32 NumPhaseBuckets = 8;
+
+    // Takes over the character's AI update and disables its actor tick
+    void RegisterCharacter(AAIBuilderCharacter* Character);
+    void UnregisterCharacter(AAIBuilderCharacter* Character);
+
+    UFUNCTION(BlueprintCallable, Category = "AI Builder")
+    int32 GetNumRegisteredCharacters() const { return Characters.Num(); }
+
+private:
+    // One slot per character, every array shares the same index
+    TArray<TWeakObjectPtr<AAIBuilderCharacter>> Characters;
+    TArray<double> NextUpdateTimes;
+    TArray<double> LastUpdateTimes;
+
+    int32 NextPhaseBucket;
+
+    // Unregistering while ticking only clears the slot, the arrays are compacted afterwards
+    bool bIsTicking;
+    bool bHasStaleSlots;
+
+    void RemoveSlot(int32 Index);
+    void RemoveStaleSlots();
+};
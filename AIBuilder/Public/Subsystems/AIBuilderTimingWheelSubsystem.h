@@ -0,0 +1,49 @@
+// AIBuilderTimingWheelSubsystem.h - Timing wheel for event driven state machines
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AIBuilderTimingWheelSubsystem.generated.h"
+
+class UAIBuilderStateMachine;
+
+// Hashed timing wheel. Scheduling is O(1), and each tick only visits the slot
+// that comes due, so thousands of sleeping agents cost nothing between wake-ups.
+UCLASS()
+class AIBUILDER_API UAIBuilderTimingWheelSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UAIBuilderTimingWheelSubsystem();
+
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Seconds covered by one slot, the resolution of every timer
+    static constexpr float SlotDuration = 0.05f;
+
+    // One lap is NumSlots * SlotDuration seconds, longer timers wait out whole laps
+    static constexpr int32 NumSlots = 256;
+
+    // Calls StateMachine->OnTimingWheelFired(Token) no earlier than Delay seconds from now.
+    // Timers are never removed, owners cancel by no longer accepting the token.
+    void Schedule(UAIBuilderStateMachine* StateMachine, uint32 Token, float Delay);
+
+private:
+    struct FTimer
+    {
+        TWeakObjectPtr<UAIBuilderStateMachine> StateMachine;
+        uint32 Token;
+        uint32 Laps;
+    };
+
+    TArray<TArray<FTimer>> Slots;
+    int32 CurrentSlot;
+    float Accumulator;
+
+    // Timers that came due this tick, fired once the slots are no longer touched
+    TArray<FTimer> DueTimers;
+};